@@ -22,6 +22,7 @@ public class PredictedMovement : ModuleRules
 				"Engine",
 				"GameplayTags",
 				"NetCore",
+				"PhysicsCore",
 			}
 			);
 	}
@@ -0,0 +1,107 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Composed/ComposedCharacter.h"
+
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Composed/ComposedMovement.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ComposedCharacter)
+
+AComposedCharacter::AComposedCharacter(const FObjectInitializer& FObjectInitializer)
+	: Super(FObjectInitializer.SetDefaultSubobjectClass<UComposedMovement>(CharacterMovementComponentName))
+	, SimulatedFeatureState(0)
+{
+	ComposedMovement = Cast<UComposedMovement>(GetCharacterMovement());
+}
+
+void AComposedCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Push Model
+	FDoRepLifetimeParams SharedParams;
+	SharedParams.bIsPushBased = true;
+	SharedParams.Condition = COND_SimulatedOnly;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SimulatedFeatureState, SharedParams);
+}
+
+void AComposedCharacter::SetSimulatedFeatureState(uint32 NewState)
+{
+	if (SimulatedFeatureState != NewState)
+	{
+		SimulatedFeatureState = NewState;
+
+		if (HasAuthority())
+		{
+			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SimulatedFeatureState, this);  // Push-model
+		}
+	}
+}
+
+void AComposedCharacter::OnRep_SimulatedFeatureState()
+{
+	if (ComposedMovement)
+	{
+		ComposedMovement->ApplySimulatedFeatureState(SimulatedFeatureState);
+	}
+}
+
+void AComposedCharacter::OnFeatureStateChanged(uint32 PrevState, uint32 NewState)
+{
+	K2_OnFeatureStateChanged();
+}
+
+bool AComposedCharacter::IsSprinting() const
+{
+	return ComposedMovement && ComposedMovement->Sprint.IsSprinting();
+}
+
+void AComposedCharacter::Sprint()
+{
+	if (ComposedMovement)
+	{
+		ComposedMovement->Sprint.bWantsToSprint = true;
+	}
+}
+
+void AComposedCharacter::UnSprint()
+{
+	if (ComposedMovement)
+	{
+		ComposedMovement->Sprint.bWantsToSprint = false;
+	}
+}
+
+bool AComposedCharacter::IsStrafing() const
+{
+	return ComposedMovement && ComposedMovement->Strafe.IsStrafing();
+}
+
+void AComposedCharacter::Strafe()
+{
+	if (ComposedMovement)
+	{
+		ComposedMovement->Strafe.bWantsToStrafe = true;
+	}
+}
+
+void AComposedCharacter::UnStrafe()
+{
+	if (ComposedMovement)
+	{
+		ComposedMovement->Strafe.bWantsToStrafe = false;
+	}
+}
+
+float AComposedCharacter::GetStamina() const
+{
+	return ComposedMovement ? ComposedMovement->Stamina.GetStamina() : 0.f;
+}
+
+bool AComposedCharacter::IsStaminaDrained() const
+{
+	return ComposedMovement && ComposedMovement->Stamina.IsStaminaDrained();
+}
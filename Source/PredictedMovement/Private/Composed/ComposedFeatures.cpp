@@ -0,0 +1,59 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Composed/ComposedFeatures.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ComposedFeatures)
+
+bool FSprintFeature::IsSprintingAtSpeed(const UCharacterMovementComponent& MoveComp) const
+{
+	if (!bIsSprinting)
+	{
+		return false;
+	}
+
+	// When moving on ground we want to factor moving uphill or downhill so variations in terrain
+	// aren't culled from the check. When falling, we don't want to factor fall velocity, only lateral
+	const float Vel = MoveComp.IsMovingOnGround() ? MoveComp.Velocity.SizeSquared() : MoveComp.Velocity.SizeSquared2D();
+	const float WalkSpeed = MoveComp.IsCrouching() ? MoveComp.MaxWalkSpeedCrouched : MoveComp.MaxWalkSpeed;
+
+	// When struggling to surpass walk speed, which can occur with heavy rotation and low acceleration, we
+	// mitigate the check so there isn't a constant re-entry that can occur as an edge case
+	return Vel >= (WalkSpeed * WalkSpeed * VelocityCheckMitigatorSprinting);
+}
+
+bool FSprintFeature::IsSprintWithinAllowableInputAngle(const UCharacterMovementComponent& MoveComp) const
+{
+	if (!bRestrictSprintInputAngle || !MoveComp.UpdatedComponent)
+	{
+		return true;
+	}
+
+	const float Dot = MoveComp.GetCurrentAcceleration().GetSafeNormal2D() | MoveComp.UpdatedComponent->GetForwardVector();
+	return Dot >= MaxInputNormalSprint;
+}
+
+void FStaminaFeature::SetStamina(float NewStamina)
+{
+	Stamina = FMath::Clamp(NewStamina, 0.f, MaxStamina);
+
+	// Drain state entry and exit, matches UStaminaMovement::OnStaminaChanged
+	if (FMath::IsNearlyZero(Stamina))
+	{
+		Stamina = 0.f;
+		bStaminaDrained = true;
+	}
+	else if (FMath::IsNearlyEqual(Stamina, MaxStamina))
+	{
+		Stamina = MaxStamina;
+		bStaminaDrained = false;
+	}
+}
+
+void FStaminaFeature::SetMaxStamina(float NewMaxStamina)
+{
+	MaxStamina = FMath::Max(0.f, NewMaxStamina);
+
+	// If the max stamina is reduced, we need to adjust the current stamina
+	SetStamina(Stamina);
+}
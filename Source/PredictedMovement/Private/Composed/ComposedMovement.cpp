@@ -0,0 +1,184 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Composed/ComposedMovement.h"
+
+#include "Composed/ComposedCharacter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ComposedMovement)
+
+UComposedMovement::UComposedMovement(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, FeatureStateBits(0)
+{
+	SetMoveResponseDataContainer(ComposedMoveResponseDataContainer);
+	SetNetworkMoveDataContainer(ComposedMoveDataContainer);
+}
+
+bool UComposedMovement::HasValidData() const
+{
+	return Super::HasValidData() && IsValid(ComposedCharacterOwner);
+}
+
+void UComposedMovement::PostLoad()
+{
+	Super::PostLoad();
+
+	ComposedCharacterOwner = Cast<AComposedCharacter>(PawnOwner);
+}
+
+void UComposedMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
+{
+	Super::SetUpdatedComponent(NewUpdatedComponent);
+
+	ComposedCharacterOwner = Cast<AComposedCharacter>(PawnOwner);
+
+	FeatureStateBits = FComposition::Initialize(*this);
+}
+
+float UComposedMovement::GetMaxAcceleration() const
+{
+	return FComposition::GetMaxAcceleration(*this, Super::GetMaxAcceleration());
+}
+
+float UComposedMovement::GetMaxSpeed() const
+{
+	return FComposition::GetMaxSpeed(*this, Super::GetMaxSpeed());
+}
+
+float UComposedMovement::GetMaxBrakingDeceleration() const
+{
+	return FComposition::GetMaxBrakingDeceleration(*this, Super::GetMaxBrakingDeceleration());
+}
+
+void UComposedMovement::CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration)
+{
+	UpdateFeatureLinks();
+
+	Friction = FComposition::CalcVelocity(*this, DeltaTime, Friction);
+	Super::CalcVelocity(DeltaTime, Friction, bFluid, BrakingDeceleration);
+}
+
+void UComposedMovement::ApplyVelocityBraking(float DeltaTime, float Friction, float BrakingDeceleration)
+{
+	Friction = FComposition::GetBrakingFriction(*this, Friction);
+	Super::ApplyVelocityBraking(DeltaTime, Friction, BrakingDeceleration);
+}
+
+void UComposedMovement::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	UpdateFeatureLinks();
+
+	// Proxies get replicated feature state.
+	if (FComposition::UpdateBeforeMovement(*this, DeltaSeconds))
+	{
+		UpdateFeatureState();
+	}
+
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+}
+
+void UComposedMovement::UpdateCharacterStateAfterMovement(float DeltaSeconds)
+{
+	// Stamina may have drained during the move
+	UpdateFeatureLinks();
+
+	// Proxies get replicated feature state.
+	if (FComposition::UpdateAfterMovement(*this, DeltaSeconds))
+	{
+		UpdateFeatureState();
+	}
+
+	Super::UpdateCharacterStateAfterMovement(DeltaSeconds);
+}
+
+void UComposedMovement::ApplySimulatedFeatureState(uint32 NewStateBits)
+{
+	FComposition::SetSimulatedStateBits(*this, NewStateBits);
+	UpdateFeatureState();
+	bNetworkUpdateReceived = true;
+}
+
+void UComposedMovement::UpdateFeatureState()
+{
+	const uint32 NewStateBits = FComposition::GetStateBits(*this);
+	if (NewStateBits != FeatureStateBits)
+	{
+		const uint32 PrevStateBits = FeatureStateBits;
+		FeatureStateBits = NewStateBits;
+
+		if (ComposedCharacterOwner)
+		{
+			ComposedCharacterOwner->SetSimulatedFeatureState(NewStateBits);
+			ComposedCharacterOwner->OnFeatureStateChanged(PrevStateBits, NewStateBits);
+		}
+	}
+}
+
+void UComposedMovement::UpdateFeatureLinks()
+{
+	// Both are derived from state that is restored with each move, so they remain predicted
+	Sprint.bSprintBlocked = Stamina.IsStaminaDrained();
+	Stamina.bDrainingStamina = Sprint.IsSprintingInEffect(*this);
+}
+
+bool UComposedMovement::ClientUpdatePositionAfterServerUpdate()
+{
+	// Replaying moves restores the inputs of each move, restore the real inputs afterward
+	const uint32 RealInputBits = FComposition::GetInputBits(*this);
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+	FComposition::SetInputBits(*this, RealInputBits);
+
+	return bResult;
+}
+
+void UComposedMovement::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+	const FVector& NewAccel)
+{
+	FComposition::ReceiveInputBits(*this, GetCurrentNetworkMoveData());
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+void UComposedMovement::OnClientCorrectionReceived(class FNetworkPredictionData_Client_Character& ClientData,
+	float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName,
+	bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode
+#if UE_5_03_OR_LATER
+	, FVector ServerGravityDirection
+#endif
+	)
+{
+	FComposition::ApplyResponseData(*this, GetMoveResponseDataContainer());
+
+	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName,
+		bHasBase, bBaseRelativePosition, ServerMovementMode
+#if UE_5_03_OR_LATER
+		, ServerGravityDirection);
+#else
+		);
+#endif
+}
+
+bool UComposedMovement::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel,
+	const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase,
+	FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	if (Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation,
+		ClientMovementBase, ClientBaseBoneName, ClientMovementMode))
+	{
+		return true;
+	}
+
+	return FComposition::ServerCheckClientError(*this, GetCurrentNetworkMoveData());
+}
+
+FNetworkPredictionData_Client* UComposedMovement::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UComposedMovement* MutableThis = const_cast<UComposedMovement*>(this);
+		MutableThis->ClientPredictionData = FComposition::AllocatePredictionData_Client(*this);
+	}
+
+	return ClientPredictionData;
+}
@@ -0,0 +1,74 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Gait/GaitCharacter.h"
+
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GaitCharacter)
+
+AGaitCharacter::AGaitCharacter(const FObjectInitializer& FObjectInitializer)
+	: Super(FObjectInitializer.SetDefaultSubobjectClass<UGaitMovement>(CharacterMovementComponentName))
+{
+	GaitMovement = Cast<UGaitMovement>(GetCharacterMovement());
+
+	Gait = EPredictedGait::Run;
+}
+
+void AGaitCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Push Model
+	FDoRepLifetimeParams SharedParams;
+	SharedParams.bIsPushBased = true;
+	SharedParams.Condition = COND_SimulatedOnly;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, Gait, SharedParams);
+}
+
+void AGaitCharacter::SetGait(EPredictedGait NewGait)
+{
+	if (Gait != NewGait)
+	{
+		Gait = NewGait;
+
+		if (HasAuthority())
+		{
+			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, Gait, this);  // Push-model
+		}
+	}
+}
+
+void AGaitCharacter::OnRep_Gait(EPredictedGait PrevGait)
+{
+	if (GaitMovement)
+	{
+		// Restore the previous gait so the movement component can notify the change
+		const EPredictedGait NewGait = Gait;
+		Gait = PrevGait;
+
+		GaitMovement->WantsGait = NewGait;
+		GaitMovement->SetGait(NewGait, true);
+		GaitMovement->bNetworkUpdateReceived = true;
+	}
+}
+
+void AGaitCharacter::RequestGait(EPredictedGait NewGait)
+{
+	if (GaitMovement && NewGait < EPredictedGait::MAX)
+	{
+		GaitMovement->WantsGait = NewGait;
+	}
+}
+
+EPredictedGait AGaitCharacter::GetWantsGait() const
+{
+	return GaitMovement ? GaitMovement->WantsGait : Gait;
+}
+
+void AGaitCharacter::OnGaitChanged(EPredictedGait PrevGait, EPredictedGait NewGait)
+{
+	K2_OnGaitChanged(PrevGait, NewGait);
+}
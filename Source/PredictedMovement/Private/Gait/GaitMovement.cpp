@@ -0,0 +1,268 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Gait/GaitMovement.h"
+
+#include "Gait/GaitCharacter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GaitMovement)
+
+namespace GaitMovement
+{
+	/**
+	 * Reserved rather than allocated, so the gait bits are stable and usable before the registry is finalized
+	 * Registered during static initialization so that it precedes any allocation
+	 */
+	static const FPredictedInputFlag& GaitInputFlag =
+		FPredictedInputFlagRegistry::Get().Reserve(TEXT("PredictedMovement.Gait"), 0, PredictedGaitNumBits);
+}
+
+UGaitMovement::UGaitMovement(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	SetNetworkMoveDataContainer(GaitMoveDataContainer);
+
+	GaitParams[(uint8)EPredictedGait::Stroll] = FGaitParams(150.f, 1024.f, 1024.f, 8.f, 0.f);
+	GaitParams[(uint8)EPredictedGait::Walk] = FGaitParams(300.f, 1536.f, 1536.f, 8.f, 0.f);
+	GaitParams[(uint8)EPredictedGait::Run] = FGaitParams(500.f, 2048.f, 2048.f, 8.f, 0.f);
+	GaitParams[(uint8)EPredictedGait::Sprint] = FGaitParams(700.f, 1024.f, 512.f, 8.f, 4.f);
+
+	WantsGait = EPredictedGait::Run;
+}
+
+bool UGaitMovement::HasValidData() const
+{
+	return Super::HasValidData() && IsValid(GaitCharacterOwner);
+}
+
+void UGaitMovement::PostLoad()
+{
+	Super::PostLoad();
+
+	GaitCharacterOwner = Cast<AGaitCharacter>(PawnOwner);
+}
+
+void UGaitMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
+{
+	Super::SetUpdatedComponent(NewUpdatedComponent);
+
+	GaitCharacterOwner = Cast<AGaitCharacter>(PawnOwner);
+}
+
+const FPredictedInputFlag& UGaitMovement::GetGaitInputFlag()
+{
+	return GaitMovement::GaitInputFlag;
+}
+
+EPredictedGait UGaitMovement::GetGait() const
+{
+	return GaitCharacterOwner ? GaitCharacterOwner->GetGait() : EPredictedGait::Run;
+}
+
+const FGaitParams* UGaitMovement::GetGaitParams() const
+{
+	if (IsMovingOnGround() && !IsCrouching())
+	{
+		const uint8 GaitIndex = (uint8)GetGait();
+		if (GaitIndex < (uint8)EPredictedGait::MAX)
+		{
+			return &GaitParams[GaitIndex];
+		}
+	}
+	return nullptr;
+}
+
+FGaitParams UGaitMovement::GetParamsForGait(EPredictedGait Gait) const
+{
+	const uint8 GaitIndex = (uint8)Gait;
+	return GaitIndex < (uint8)EPredictedGait::MAX ? GaitParams[GaitIndex] : FGaitParams();
+}
+
+void UGaitMovement::SetParamsForGait(EPredictedGait Gait, const FGaitParams& Params)
+{
+	const uint8 GaitIndex = (uint8)Gait;
+	if (GaitIndex < (uint8)EPredictedGait::MAX)
+	{
+		GaitParams[GaitIndex] = Params;
+	}
+}
+
+float UGaitMovement::GetMaxAcceleration() const
+{
+	if (const FGaitParams* Params = GetGaitParams())
+	{
+		return Params->MaxAcceleration;
+	}
+	return Super::GetMaxAcceleration();
+}
+
+float UGaitMovement::GetMaxSpeed() const
+{
+	if (const FGaitParams* Params = GetGaitParams())
+	{
+		return Params->MaxWalkSpeed;
+	}
+	return Super::GetMaxSpeed();
+}
+
+float UGaitMovement::GetMaxBrakingDeceleration() const
+{
+	if (const FGaitParams* Params = GetGaitParams())
+	{
+		return Params->BrakingDeceleration;
+	}
+	return Super::GetMaxBrakingDeceleration();
+}
+
+void UGaitMovement::CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration)
+{
+	if (const FGaitParams* Params = GetGaitParams())
+	{
+		Friction = Params->GroundFriction;
+	}
+	Super::CalcVelocity(DeltaTime, Friction, bFluid, BrakingDeceleration);
+}
+
+void UGaitMovement::ApplyVelocityBraking(float DeltaTime, float Friction, float BrakingDeceleration)
+{
+	if (const FGaitParams* Params = GetGaitParams())
+	{
+		Friction = (bUseSeparateBrakingFriction ? Params->BrakingFriction : Params->GroundFriction);
+	}
+	Super::ApplyVelocityBraking(DeltaTime, Friction, BrakingDeceleration);
+}
+
+void UGaitMovement::SetGait(EPredictedGait NewGait, bool bClientSimulation)
+{
+	if (!HasValidData())
+	{
+		return;
+	}
+
+	if (!bClientSimulation && !CanGaitInCurrentState(NewGait))
+	{
+		NewGait = GetAllowedGait(NewGait);
+	}
+
+	const EPredictedGait PrevGait = GaitCharacterOwner->GetGait();
+	if (PrevGait != NewGait)
+	{
+		GaitCharacterOwner->SetGait(NewGait);
+		GaitCharacterOwner->OnGaitChanged(PrevGait, NewGait);
+	}
+}
+
+bool UGaitMovement::CanGaitInCurrentState(EPredictedGait InGait) const
+{
+	if (InGait <= EPredictedGait::Walk)
+	{
+		return true;
+	}
+
+	if (!UpdatedComponent || UpdatedComponent->IsSimulatingPhysics())
+	{
+		return false;
+	}
+
+	if (!IsFalling() && !IsMovingOnGround())
+	{
+		return false;
+	}
+
+	return true;
+}
+
+EPredictedGait UGaitMovement::GetAllowedGait(EPredictedGait InGait) const
+{
+	uint8 GaitIndex = FMath::Min<uint8>((uint8)InGait, (uint8)EPredictedGait::MAX - 1);
+	while (GaitIndex > 0 && !CanGaitInCurrentState((EPredictedGait)GaitIndex))
+	{
+		--GaitIndex;
+	}
+	return (EPredictedGait)GaitIndex;
+}
+
+void UGaitMovement::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	// Proxies get replicated Gait state.
+	if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
+	{
+		// Check for a change in Gait state. Players change Gait by changing WantsGait.
+		const EPredictedGait NewGait = GetAllowedGait(WantsGait);
+		if (NewGait != GetGait())
+		{
+			SetGait(NewGait, false);
+		}
+	}
+
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+}
+
+void UGaitMovement::UpdateCharacterStateAfterMovement(float DeltaSeconds)
+{
+	// Proxies get replicated Gait state.
+	if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
+	{
+		// Drop to an allowed gait if the current gait is no longer allowed
+		const EPredictedGait CurrentGait = GetGait();
+		if (!CanGaitInCurrentState(CurrentGait))
+		{
+			SetGait(GetAllowedGait(CurrentGait), false);
+		}
+	}
+
+	Super::UpdateCharacterStateAfterMovement(DeltaSeconds);
+}
+
+bool UGaitMovement::ClientUpdatePositionAfterServerUpdate()
+{
+	const EPredictedGait RealGait = WantsGait;
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+	WantsGait = RealGait;
+
+	return bResult;
+}
+
+void UGaitMovement::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+	const FVector& NewAccel)
+{
+	// Server receives the gait in the extended input flags, replays restore it from the saved move instead
+	if (const FCharacterNetworkMoveData* MoveData = GetCurrentNetworkMoveData())
+	{
+		const FPredictedInputFlags& InputFlags = static_cast<const FPredictedInputNetworkMoveData*>(MoveData)->InputFlags;
+		WantsGait = (EPredictedGait)FMath::Min<uint32>(InputFlags.GetValue(GetGaitInputFlag()), (uint8)EPredictedGait::MAX - 1);
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+void FSavedMove_Character_Gait::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel,
+	FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+	InputFlags.SetValue(UGaitMovement::GetGaitInputFlag(), (uint32)Cast<AGaitCharacter>(C)->GetGaitCharacterMovement()->WantsGait);
+}
+
+void FSavedMove_Character_Gait::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	Cast<AGaitCharacter>(C)->GetGaitCharacterMovement()->WantsGait = (EPredictedGait)InputFlags.GetValue(UGaitMovement::GetGaitInputFlag());
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Character_Gait::AllocateNewMove()
+{
+	return MakeShared<FSavedMove_Character_Gait>();
+}
+
+FNetworkPredictionData_Client* UGaitMovement::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UGaitMovement* MutableThis = const_cast<UGaitMovement*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Character_Gait(*this);
+	}
+
+	return ClientPredictionData;
+}
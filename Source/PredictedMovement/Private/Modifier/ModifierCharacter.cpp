@@ -4,12 +4,17 @@
 #include "Modifier/ModifierCharacter.h"
 
 #include "Modifier/ModifierTags.h"
+#include "System/PredictedMovementStats.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
 #include "Net/UnrealNetwork.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "PredictedMovement/Public/Modifier/ModifierMovement.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierCharacter)
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Modifier Updates Suppressed"), STAT_SimulatedModifierUpdatesSuppressed, STATGROUP_PredictedMovement);
+
 
 AModifierCharacter::AModifierCharacter(const FObjectInitializer& FObjectInitializer)
 	: Super(FObjectInitializer.SetDefaultSubobjectClass<UModifierMovement>(CharacterMovementComponentName))
@@ -26,9 +31,18 @@ void AModifierCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
 	SharedParams.bIsPushBased = true;
 	SharedParams.Condition = COND_SimulatedOnly;
 	
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SimulatedBoost, SharedParams);
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SimulatedSnare, SharedParams);
-	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SimulatedSlowFall, SharedParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SimulatedModifierLevels, SharedParams);
+}
+
+void AModifierCharacter::PawnClientRestart()
+{
+	Super::PawnClientRestart();
+
+	// Modifier levels are sent as indexes, make sure ours match the server
+	if (ModifierMovement)
+	{
+		ModifierMovement->VerifyModifierLevels();
+	}
 }
 
 void AModifierCharacter::OnModifierChanged(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel,
@@ -41,22 +55,206 @@ void AModifierCharacter::OnModifierChanged(const FGameplayTag& ModifierType, con
 	{
 		if (ModifierType == FModifierTags::Modifier_Boost)
 		{
-			SimulatedBoost = ModifierMovement->GetBoostLevelIndex(ModifierLevel);
-			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SimulatedBoost, this);
+			SetSimulatedModifierLevel(ModifierType, ModifierMovement->GetBoostLevelIndex(ModifierLevel));
 		}
 		else if (ModifierType == FModifierTags::Modifier_Snare)
 		{
-			SimulatedSnare = ModifierMovement->GetSnareLevelIndex(ModifierLevel);
-			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SimulatedSnare, this);
+			SetSimulatedModifierLevel(ModifierType, ModifierMovement->GetSnareLevelIndex(ModifierLevel));
 		}
 		else if (ModifierType == FModifierTags::Modifier_SlowFall)
 		{
-			SimulatedSlowFall = ModifierMovement->GetSlowFallLevelIndex(ModifierLevel);
-			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SimulatedSlowFall, this);
+			SetSimulatedModifierLevel(ModifierType, ModifierMovement->GetSlowFallLevelIndex(ModifierLevel));
 		}
 	}
 }
 
+void AModifierCharacter::SetSimulatedModifierLevel(const FGameplayTag& ModifierType, uint8 Level)
+{
+	ESimulatedModifier Modifier;
+	if (ModifierType == FModifierTags::Modifier_Boost)
+	{
+		Modifier = ESimulatedModifier::Boost;
+	}
+	else if (ModifierType == FModifierTags::Modifier_Snare)
+	{
+		Modifier = ESimulatedModifier::Snare;
+	}
+	else if (ModifierType == FModifierTags::Modifier_SlowFall)
+	{
+		Modifier = ESimulatedModifier::SlowFall;
+	}
+	else
+	{
+		return;
+	}
+
+	const bool bWasPending = PendingSimulatedModifierLevels.Get(Modifier) != SimulatedModifierLevels.Get(Modifier);
+	if (!PendingSimulatedModifierLevels.Set(Modifier, Level))
+	{
+		return;
+	}
+
+	// The previous pending level was never sent
+	if (bWasPending)
+	{
+		NumSuppressedSimulatedModifierUpdates++;
+		INC_DWORD_STAT(STAT_SimulatedModifierUpdatesSuppressed);
+	}
+
+	if (Level != SimulatedModifierLevels.Get(Modifier) && SimulatedModifierWindowStart < 0.0)
+	{
+		SimulatedModifierWindowStart = GetWorld()->GetTimeSeconds();
+	}
+
+	// Changes to several levels within the same frame are sent as one property update
+	if (SimulatedModifierCoalesceWindow <= 0.f && SimulatedModifierMinHoldTime <= 0.f)
+	{
+		FlushSimulatedModifierLevels();
+	}
+}
+
+void AModifierCharacter::FlushSimulatedModifierLevels()
+{
+	if (SimulatedModifierWindowStart < 0.0)
+	{
+		return;
+	}
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	if (Time < SimulatedModifierWindowStart + SimulatedModifierCoalesceWindow)
+	{
+		return;
+	}
+
+	bool bChanged = false;
+	bool bStillPending = false;
+	for (uint8 i = 0; i < (uint8)ESimulatedModifier::MAX; ++i)
+	{
+		const ESimulatedModifier Modifier = (ESimulatedModifier)i;
+		const uint8 Level = PendingSimulatedModifierLevels.Get(Modifier);
+		if (Level == SimulatedModifierLevels.Get(Modifier))
+		{
+			continue;
+		}
+
+		// Keep the current level on proxies for at least the hold time
+		if (SimulatedModifierChangeTimes[i] > 0.0 && Time < SimulatedModifierChangeTimes[i] + SimulatedModifierMinHoldTime)
+		{
+			bStillPending = true;
+			continue;
+		}
+
+		SimulatedModifierLevels.Set(Modifier, Level);
+		SimulatedModifierChangeTimes[i] = Time;
+		bChanged = true;
+	}
+
+	SimulatedModifierWindowStart = bStillPending ? SimulatedModifierWindowStart : -1.0;
+
+	if (bChanged)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SimulatedModifierLevels, this);  // Push-model
+	}
+}
+
+void AModifierCharacter::OnRep_SimulatedModifierLevels()
+{
+	if (!ModifierMovement)
+	{
+		return;
+	}
+
+	// Movement always uses the latest levels
+	ModifierMovement->BoostLevel = SimulatedModifierLevels.Get(ESimulatedModifier::Boost);
+	ModifierMovement->SnareLevel = SimulatedModifierLevels.Get(ESimulatedModifier::Snare);
+	ModifierMovement->SlowFallLevel = SimulatedModifierLevels.Get(ESimulatedModifier::SlowFall);
+	ModifierMovement->bNetworkUpdateReceived = true;
+
+	// Only the cosmetic events are subject to LOD
+	if (ProxyModifierLOD == EModifierProxyLOD::Disabled || bProxyModifierSignificant)
+	{
+		DispatchSimulatedModifierEvents();
+	}
+	else if (ProxyModifierLOD == EModifierProxyLOD::Drop)
+	{
+		NotifiedModifierLevels = SimulatedModifierLevels;
+	}
+}
+
+void AModifierCharacter::DispatchSimulatedModifierEvents()
+{
+	const uint8 ChangedMask = SimulatedModifierLevels.GetChangedMask(NotifiedModifierLevels);
+	if (!ModifierMovement || ChangedMask == 0)
+	{
+		return;
+	}
+
+	// Intermediate levels that were deferred are skipped, only the latest is dispatched
+	const FSimulatedModifierLevels PrevLevels = NotifiedModifierLevels;
+	NotifiedModifierLevels = SimulatedModifierLevels;
+
+	if (ChangedMask & (1 << (uint8)ESimulatedModifier::Boost))
+	{
+		OnSimulatedBoostChanged(PrevLevels.Get(ESimulatedModifier::Boost));
+	}
+	if (ChangedMask & (1 << (uint8)ESimulatedModifier::Snare))
+	{
+		OnSimulatedSnareChanged(PrevLevels.Get(ESimulatedModifier::Snare));
+	}
+	if (ChangedMask & (1 << (uint8)ESimulatedModifier::SlowFall))
+	{
+		OnSimulatedSlowFallChanged(PrevLevels.Get(ESimulatedModifier::SlowFall));
+	}
+}
+
+void AModifierCharacter::UpdateProxyModifierLOD()
+{
+	if (ProxyModifierLOD == EModifierProxyLOD::Disabled)
+	{
+		return;
+	}
+
+	const double Time = GetWorld()->GetTimeSeconds();
+	if (Time < NextProxyModifierLODTime)
+	{
+		return;
+	}
+	NextProxyModifierLODTime = Time + ProxyModifierLODInterval;
+
+	const bool bWasSignificant = bProxyModifierSignificant;
+	bProxyModifierSignificant = IsModifierProxySignificant();
+
+	// Catch up to the latest levels in one step
+	if (bProxyModifierSignificant && !bWasSignificant)
+	{
+		DispatchSimulatedModifierEvents();
+	}
+}
+
+bool AModifierCharacter::IsModifierProxySignificant() const
+{
+	if (bProxyModifierLODRequireRendered && !WasRecentlyRendered(0.2f))
+	{
+		return false;
+	}
+
+	if (ProxyModifierLODDistance > 0.f)
+	{
+		if (const APlayerController* PC = GetWorld()->GetFirstPlayerController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			if (FVector::DistSquared(ViewLocation, GetActorLocation()) > FMath::Square(ProxyModifierLODDistance))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 void AModifierCharacter::OnModifierAdded(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel,
 	const FGameplayTag& PrevModifierLevel)
 {
@@ -79,51 +277,71 @@ void AModifierCharacter::GrantClientAuthority(FGameplayTag ClientAuthSource, flo
 
 /* Boost Implementation */
 
-void AModifierCharacter::OnRep_SimulatedBoost(uint8 PrevLevel)
+void AModifierCharacter::OnSimulatedBoostChanged(uint8 PrevLevel)
 {
-	if (ModifierMovement && SimulatedBoost != PrevLevel)
-	{
-		const FGameplayTag PrevBoostLevel = ModifierMovement->GetBoostLevel();
-		ModifierMovement->BoostLevel = SimulatedBoost;
-		NotifyModifierChanged<uint8>(FModifierTags::Modifier_Boost, ModifierMovement->GetBoostLevel(),
-			PrevBoostLevel, ModifierMovement->BoostLevel, PrevLevel, NO_MODIFIER);
+	const TArray<FGameplayTag>& Levels = ModifierMovement->GetBoostLevels();
+	const FGameplayTag PrevBoostLevel = Levels.IsValidIndex(PrevLevel) ? Levels[PrevLevel] : FGameplayTag::EmptyTag;
+	NotifyModifierChanged<uint8>(FModifierTags::Modifier_Boost, ModifierMovement->GetBoostLevel(),
+		PrevBoostLevel, ModifierMovement->BoostLevel, PrevLevel, NO_MODIFIER);
+}
 
-		ModifierMovement->bNetworkUpdateReceived = true;
+FModifierHandle AModifierCharacter::Boost(FGameplayTag Level, EModifierNetType NetType, float Duration)
+{
+	if (ModifierMovement && Level.IsValid())
+	{
+		return BoostByIndex(ModifierMovement->GetBoostLevelIndex(Level), NetType, Duration);
 	}
+	return {};
 }
 
-bool AModifierCharacter::Boost(FGameplayTag Level, EModifierNetType NetType)
+FModifierHandle AModifierCharacter::BoostByIndex(uint8 LevelIndex, EModifierNetType NetType, float Duration)
 {
-	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Level.IsValid())
+	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy)
 	{
-		const uint8 LevelIndex = ModifierMovement->GetBoostLevelIndex(Level);
-		if (LevelIndex == NO_MODIFIER)
+		if (!ModifierMovement->GetBoostLevels().IsValidIndex(LevelIndex))
 		{
-			return false;
+			return {};
 		}
-		
+
+		const float Expiry = ModifierMovement->GetModifierExpiry(Duration);
+
+		FModifierHandle Handle;
 		switch (NetType)
 		{
 		case EModifierNetType::LocalPredicted:
-			return ModifierMovement->BoostLocal.AddModifier(LevelIndex);
+			Handle = ModifierMovement->BoostLocal.AddModifier(LevelIndex, Expiry);
+			break;
 		case EModifierNetType::WithCorrection:
-			return ModifierMovement->BoostCorrection.AddModifier(LevelIndex);
+			Handle = ModifierMovement->BoostCorrection.AddModifier(LevelIndex, Expiry);
+			break;
 		case EModifierNetType::ServerInitiated:
 			if (HasAuthority())
 			{
-				return ModifierMovement->BoostServer.AddModifier(LevelIndex);
+				Handle = ModifierMovement->BoostServer.AddModifier(LevelIndex, Expiry);
 			}
-		default: return false;
+			break;
+		default: return {};
 		}
+		Handle.NetType = NetType;
+		Handle.ModifierType = FModifierTags::Modifier_Boost;
+		return Handle;
 	}
-	return false;
+	return {};
 }
 
 bool AModifierCharacter::UnBoost(FGameplayTag Level, EModifierNetType NetType, bool bRemoveAll)
 {
-	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Level.IsValid())
+	if (ModifierMovement && Level.IsValid())
+	{
+		return UnBoostByIndex(ModifierMovement->GetBoostLevelIndex(Level), NetType, bRemoveAll);
+	}
+	return false;
+}
+
+bool AModifierCharacter::UnBoostByIndex(uint8 LevelIndex, EModifierNetType NetType, bool bRemoveAll)
+{
+	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy)
 	{
-		const uint8 LevelIndex = ModifierMovement->GetBoostLevelIndex(Level);
 		if (LevelIndex == NO_MODIFIER)
 		{
 			return false;
@@ -146,6 +364,28 @@ bool AModifierCharacter::UnBoost(FGameplayTag Level, EModifierNetType NetType, b
 	return false;
 }
 
+bool AModifierCharacter::UnBoostByHandle(const FModifierHandle& Handle)
+{
+	// Slots overlap between modifiers, don't remove another modifier's slot
+	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Handle.IsValid() && Handle.ModifierType == FModifierTags::Modifier_Boost)
+	{
+		switch (Handle.NetType)
+		{
+		case EModifierNetType::LocalPredicted:
+			return ModifierMovement->BoostLocal.RemoveModifierByHandle(Handle);
+		case EModifierNetType::WithCorrection:
+			return ModifierMovement->BoostCorrection.RemoveModifierByHandle(Handle);
+		case EModifierNetType::ServerInitiated:
+			if (HasAuthority())
+			{
+				return ModifierMovement->BoostServer.RemoveModifierByHandle(Handle);
+			}
+		default: return false;
+		}
+	}
+	return false;
+}
+
 bool AModifierCharacter::ResetBoost(EModifierNetType NetType)
 {
 	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy)
@@ -181,39 +421,53 @@ bool AModifierCharacter::IsBoostActive() const
 
 /* Snare Implementation */
 
-void AModifierCharacter::OnRep_SimulatedSnare(uint8 PrevLevel)
+void AModifierCharacter::OnSimulatedSnareChanged(uint8 PrevLevel)
 {
-	if (ModifierMovement && SimulatedSnare != PrevLevel)
-	{
-		const FGameplayTag PrevSnareLevel = ModifierMovement->GetSnareLevel();
-		ModifierMovement->SnareLevel = SimulatedSnare;
-		NotifyModifierChanged<uint8>(FModifierTags::Modifier_Snare, ModifierMovement->GetSnareLevel(),
-			PrevSnareLevel, ModifierMovement->SnareLevel, PrevLevel, NO_MODIFIER);
+	const TArray<FGameplayTag>& Levels = ModifierMovement->GetSnareLevels();
+	const FGameplayTag PrevSnareLevel = Levels.IsValidIndex(PrevLevel) ? Levels[PrevLevel] : FGameplayTag::EmptyTag;
+	NotifyModifierChanged<uint8>(FModifierTags::Modifier_Snare, ModifierMovement->GetSnareLevel(),
+		PrevSnareLevel, ModifierMovement->SnareLevel, PrevLevel, NO_MODIFIER);
+}
 
-		ModifierMovement->bNetworkUpdateReceived = true;
+FModifierHandle AModifierCharacter::Snare(FGameplayTag Level, float Duration)
+{
+	if (ModifierMovement && Level.IsValid())
+	{
+		return SnareByIndex(ModifierMovement->GetSnareLevelIndex(Level), Duration);
 	}
+	return {};
 }
 
-bool AModifierCharacter::Snare(FGameplayTag Level)
+FModifierHandle AModifierCharacter::SnareByIndex(uint8 LevelIndex, float Duration)
 {
-	if (ModifierMovement && HasAuthority() && Level.IsValid())
+	if (ModifierMovement && HasAuthority())
 	{
-		const uint8 LevelIndex = ModifierMovement->GetSnareLevelIndex(Level);
-		if (LevelIndex == NO_MODIFIER)
+		if (!ModifierMovement->GetSnareLevels().IsValidIndex(LevelIndex))
 		{
-			return false;
+			return {};
 		}
 		
-		return ModifierMovement->SnareServer.AddModifier(LevelIndex);
+		FModifierHandle Handle = ModifierMovement->SnareServer.AddModifier(LevelIndex, ModifierMovement->GetModifierExpiry(Duration));
+		Handle.NetType = EModifierNetType::ServerInitiated;
+		Handle.ModifierType = FModifierTags::Modifier_Snare;
+		return Handle;
 	}
-	return false;
+	return {};
 }
 
 bool AModifierCharacter::UnSnare(FGameplayTag Level, bool bRemoveAll)
 {
-	if (ModifierMovement && HasAuthority() && Level.IsValid())
+	if (ModifierMovement && Level.IsValid())
+	{
+		return UnSnareByIndex(ModifierMovement->GetSnareLevelIndex(Level), bRemoveAll);
+	}
+	return false;
+}
+
+bool AModifierCharacter::UnSnareByIndex(uint8 LevelIndex, bool bRemoveAll)
+{
+	if (ModifierMovement && HasAuthority())
 	{
-		const uint8 LevelIndex = ModifierMovement->GetSnareLevelIndex(Level);
 		if (LevelIndex == NO_MODIFIER)
 		{
 			return false;
@@ -224,6 +478,15 @@ bool AModifierCharacter::UnSnare(FGameplayTag Level, bool bRemoveAll)
 	return false;
 }
 
+bool AModifierCharacter::UnSnareByHandle(const FModifierHandle& Handle)
+{
+	if (ModifierMovement && HasAuthority() && Handle.IsFor(FModifierTags::Modifier_Snare, EModifierNetType::ServerInitiated))
+	{
+		return ModifierMovement->SnareServer.RemoveModifierByHandle(Handle);
+	}
+	return false;
+}
+
 bool AModifierCharacter::ResetSnare()
 {
 	if (ModifierMovement && HasAuthority())
@@ -247,32 +510,30 @@ bool AModifierCharacter::IsSnareActive() const
 
 /* SlowFall Implementation */
 
-void AModifierCharacter::OnRep_SimulatedSlowFall(uint8 PrevLevel)
+void AModifierCharacter::OnSimulatedSlowFallChanged(uint8 PrevLevel)
 {
-	if (ModifierMovement && SimulatedSlowFall != PrevLevel)
-	{
-		const FGameplayTag PrevSlowFallLevel = ModifierMovement->GetSlowFallLevel();
-		ModifierMovement->SlowFallLevel = SimulatedSlowFall;
-		NotifyModifierChanged<uint8>(FModifierTags::Modifier_SlowFall, ModifierMovement->GetSlowFallLevel(),
-			PrevSlowFallLevel, ModifierMovement->SlowFallLevel, PrevLevel, NO_MODIFIER);
-
-		ModifierMovement->bNetworkUpdateReceived = true;
-	}
+	const TArray<FGameplayTag>& Levels = ModifierMovement->GetSlowFallLevels();
+	const FGameplayTag PrevSlowFallLevel = Levels.IsValidIndex(PrevLevel) ? Levels[PrevLevel] : FGameplayTag::EmptyTag;
+	NotifyModifierChanged<uint8>(FModifierTags::Modifier_SlowFall, ModifierMovement->GetSlowFallLevel(),
+		PrevSlowFallLevel, ModifierMovement->SlowFallLevel, PrevLevel, NO_MODIFIER);
 }
 
-bool AModifierCharacter::SlowFall(FGameplayTag Level)
+FModifierHandle AModifierCharacter::SlowFall(FGameplayTag Level, float Duration)
 {
 	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Level.IsValid())
 	{
 		const uint8 LevelIndex = ModifierMovement->GetSlowFallLevelIndex(Level);
 		if (LevelIndex == NO_MODIFIER)
 		{
-			return false;
+			return {};
 		}
 		
-		return ModifierMovement->SlowFallLocal.AddModifier(LevelIndex);
+		FModifierHandle Handle = ModifierMovement->SlowFallLocal.AddModifier(LevelIndex, ModifierMovement->GetModifierExpiry(Duration));
+		Handle.NetType = EModifierNetType::LocalPredicted;
+		Handle.ModifierType = FModifierTags::Modifier_SlowFall;
+		return Handle;
 	}
-	return false;
+	return {};
 }
 
 bool AModifierCharacter::UnSlowFall(FGameplayTag Level, bool bRemoveAll)
@@ -290,6 +551,15 @@ bool AModifierCharacter::UnSlowFall(FGameplayTag Level, bool bRemoveAll)
 	return false;
 }
 
+bool AModifierCharacter::UnSlowFallByHandle(const FModifierHandle& Handle)
+{
+	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Handle.IsFor(FModifierTags::Modifier_SlowFall, EModifierNetType::LocalPredicted))
+	{
+		return ModifierMovement->SlowFallLocal.RemoveModifierByHandle(Handle);
+	}
+	return false;
+}
+
 bool AModifierCharacter::ResetSlowFall()
 {
 	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy)
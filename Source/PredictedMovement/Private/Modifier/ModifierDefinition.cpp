@@ -0,0 +1,285 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierDefinition.h"
+
+#include "Modifier/ModifierTags.h"
+#include "Misc/ComparisonUtility.h"
+#include "UObject/UObjectIterator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierDefinition)
+
+DEFINE_LOG_CATEGORY_STATIC(LogModifierDefinition, Log, All);
+
+namespace ModifierTables
+{
+	template<typename T>
+	static void BuildLevels(const TMap<FGameplayTag, T>& Params, TArray<FGameplayTag>& OutLevels, TArray<T>& OutParams,
+		uint32& Checksum)
+	{
+		Params.GenerateKeyArray(OutLevels);
+
+		// TMap order depends on the order levels were added and removed, which can differ between client and server
+		OutLevels.Sort([](const FGameplayTag& A, const FGameplayTag& B)
+		{
+			return UE::ComparisonUtility::CompareNaturalOrder(A.ToString(), B.ToString()) < 0;
+		});
+
+		OutParams.Reset(OutLevels.Num());
+		for (const FGameplayTag& Level : OutLevels)
+		{
+			OutParams.Add(Params.FindChecked(Level));
+		}
+
+		Checksum = FCrc::TypeCrc32(OutLevels.Num(), Checksum);
+		for (const FGameplayTag& Level : OutLevels)
+		{
+			Checksum = FCrc::StrCrc32(*Level.ToString(), Checksum);
+		}
+	}
+
+	template<typename T>
+	static uint32 HashParams(const T& Params, uint32 Version)
+	{
+		// Exported as text so the hash doesn't depend on padding, or on pointers that differ between processes
+		FString Text;
+		T::StaticStruct()->ExportText(Text, &Params, nullptr, nullptr, PPF_None, nullptr);
+		return FCrc::StrCrc32(*Text, Version);
+	}
+
+	template<typename T>
+	static void MergeParams(const TArray<FGameplayTag>& Levels, TArray<T>& Params, const TArray<FGameplayTag>& SourceLevels,
+		const TArray<T>& SourceParams, const TSet<FGameplayTag>& Keep)
+	{
+		for (int32 i = 0; i < Levels.Num(); ++i)
+		{
+			const int32 SourceIndex = Keep.Contains(Levels[i]) ? INDEX_NONE : SourceLevels.IndexOfByKey(Levels[i]);
+			if (SourceIndex != INDEX_NONE)
+			{
+				Params[i] = SourceParams[SourceIndex];
+			}
+		}
+	}
+
+	template<typename T>
+	static bool SetParam(TMap<FGameplayTag, T>& Params, const FGameplayTag& Level, FName PropertyName, const FString& Value)
+	{
+		T* LevelParams = Params.Find(Level);
+		const FProperty* Property = LevelParams ? T::StaticStruct()->FindPropertyByName(PropertyName) : nullptr;
+		if (!Property)
+		{
+			return false;
+		}
+		return Property->ImportText_InContainer(*Value, LevelParams, nullptr, PPF_None) != nullptr;
+	}
+}
+
+TSharedRef<FModifierTables> FModifierTables::Build(const TMap<FGameplayTag, FMovementModifierParams>& Boost,
+	const TMap<FGameplayTag, FMovementModifierParams>& Snare, const TMap<FGameplayTag, FFallingModifierParams>& SlowFall,
+	const TMap<FGameplayTag, FClientAuthParams>& ClientAuthParams)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierTables::Build);
+
+	TSharedRef<FModifierTables> Tables = MakeShared<FModifierTables>();
+
+	uint32 Checksum = 0;
+	ModifierTables::BuildLevels(Boost, Tables->BoostLevels, Tables->BoostParams, Checksum);
+	ModifierTables::BuildLevels(Snare, Tables->SnareLevels, Tables->SnareParams, Checksum);
+	ModifierTables::BuildLevels(SlowFall, Tables->SlowFallLevels, Tables->SlowFallParams, Checksum);
+	Tables->Checksum = Checksum;
+
+	for (FFallingModifierParams& Params : Tables->SlowFallParams)
+	{
+		Params.BakeGravityScalarTable();
+	}
+
+	Tables->ClientAuthParams = ClientAuthParams;
+	Tables->UpdateVersion();
+
+	return Tables;
+}
+
+TSharedRef<FModifierTables> FModifierTables::MergeParams(const FModifierTables& Current, const FModifierTables& Source,
+	const TSet<FGameplayTag>& Keep)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierTables::MergeParams);
+
+	TSharedRef<FModifierTables> Tables = MakeShared<FModifierTables>(Current);
+
+	// SlowFall params are already baked by Source
+	ModifierTables::MergeParams(Tables->BoostLevels, Tables->BoostParams, Source.BoostLevels, Source.BoostParams, Keep);
+	ModifierTables::MergeParams(Tables->SnareLevels, Tables->SnareParams, Source.SnareLevels, Source.SnareParams, Keep);
+	ModifierTables::MergeParams(Tables->SlowFallLevels, Tables->SlowFallParams, Source.SlowFallLevels, Source.SlowFallParams, Keep);
+
+	// Client auth is looked up by source rather than index, so sources can be added and removed freely
+	Tables->ClientAuthParams = Source.ClientAuthParams;
+	for (const TPair<FGameplayTag, FClientAuthParams>& Pair : Current.ClientAuthParams)
+	{
+		if (Keep.Contains(Pair.Key))
+		{
+			Tables->ClientAuthParams.Add(Pair.Key, Pair.Value);
+		}
+	}
+
+	Tables->UpdateVersion();
+	return Tables;
+}
+
+void FModifierTables::UpdateVersion()
+{
+	// Version covers the params too, in the same order on every process
+	uint32 NewVersion = Checksum;
+	for (const FMovementModifierParams& Params : BoostParams) { NewVersion = ModifierTables::HashParams(Params, NewVersion); }
+	for (const FMovementModifierParams& Params : SnareParams) { NewVersion = ModifierTables::HashParams(Params, NewVersion); }
+	for (const FFallingModifierParams& Params : SlowFallParams) { NewVersion = ModifierTables::HashParams(Params, NewVersion); }
+
+	TArray<FGameplayTag> Sources;
+	ClientAuthParams.GenerateKeyArray(Sources);
+	Sources.Sort([](const FGameplayTag& A, const FGameplayTag& B) { return A.ToString() < B.ToString(); });
+	for (const FGameplayTag& Source : Sources)
+	{
+		NewVersion = FCrc::StrCrc32(*Source.ToString(), NewVersion);
+		NewVersion = ModifierTables::HashParams(ClientAuthParams.FindChecked(Source), NewVersion);
+	}
+	Version = NewVersion;
+}
+
+TSharedRef<const FModifierTables> FModifierTables::GetEmpty()
+{
+	static const TSharedRef<const FModifierTables> Empty = MakeShared<FModifierTables>();
+	return Empty;
+}
+
+SIZE_T FModifierTables::GetAllocatedSize() const
+{
+	return sizeof(FModifierTables)
+		+ BoostLevels.GetAllocatedSize() + SnareLevels.GetAllocatedSize() + SlowFallLevels.GetAllocatedSize()
+		+ BoostParams.GetAllocatedSize() + SnareParams.GetAllocatedSize() + SlowFallParams.GetAllocatedSize()
+		+ ClientAuthParams.GetAllocatedSize();
+}
+
+void UModifierDefinition::PostLoad()
+{
+	Super::PostLoad();
+
+	Compile();
+}
+
+#if WITH_EDITOR
+void UModifierDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	Compile();
+}
+#endif
+
+TSharedRef<const FModifierTables> UModifierDefinition::GetTables() const
+{
+	if (!Tables.IsValid())
+	{
+		Tables = FModifierTables::Build(Boost, Snare, SlowFall, ClientAuthParams);
+	}
+	return Tables.ToSharedRef();
+}
+
+void UModifierDefinition::Compile()
+{
+	const uint32 PrevVersion = Tables.IsValid() ? Tables->Version : 0;
+	const bool bWasCompiled = Tables.IsValid();
+
+	// Swap in one assignment, anything still holding the previous tables keeps them alive
+	Tables = FModifierTables::Build(Boost, Snare, SlowFall, ClientAuthParams);
+
+	if (bWasCompiled && Tables->Version != PrevVersion)
+	{
+		UE_LOG(LogModifierDefinition, Log, TEXT("%s: Compiled version %08X"), *GetName(), Tables->Version);
+		OnTablesChanged.Broadcast();
+	}
+}
+
+bool UModifierDefinition::SetParam(const FGameplayTag& Level, FName PropertyName, const FString& Value)
+{
+	bool bResult = false;
+	if (Level.MatchesTag(FModifierTags::Modifier_Boost))
+	{
+		bResult = ModifierTables::SetParam(Boost, Level, PropertyName, Value);
+	}
+	else if (Level.MatchesTag(FModifierTags::Modifier_Snare))
+	{
+		bResult = ModifierTables::SetParam(Snare, Level, PropertyName, Value);
+	}
+	else if (Level.MatchesTag(FModifierTags::Modifier_SlowFall))
+	{
+		bResult = ModifierTables::SetParam(SlowFall, Level, PropertyName, Value);
+	}
+	else
+	{
+		bResult = ModifierTables::SetParam(ClientAuthParams, Level, PropertyName, Value);
+	}
+
+	if (bResult)
+	{
+		Compile();
+	}
+	return bResult;
+}
+
+#if !UE_BUILD_SHIPPING
+namespace ModifierDefinitionCommands
+{
+	static UModifierDefinition* FindDefinition(const FString& Name)
+	{
+		for (TObjectIterator<UModifierDefinition> It; It; ++It)
+		{
+			if (It->GetName() == Name && !It->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+
+	static FAutoConsoleCommand SetParamCommand(
+		TEXT("p.Modifier.SetParam"),
+		TEXT("Set a param of a loaded modifier definition, and swap every character using it to the new tables.\n")
+		TEXT("Must be run on both client and server, e.g. with ServerExec, or they will report mismatched versions.\n")
+		TEXT("Usage: p.Modifier.SetParam <Definition> <Level> <Param> <Value>\n")
+		TEXT("e.g. p.Modifier.SetParam DA_Modifiers Modifier.Boost MaxWalkSpeed 1.75"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() < 4)
+			{
+				UE_LOG(LogModifierDefinition, Warning, TEXT("Usage: p.Modifier.SetParam <Definition> <Level> <Param> <Value>"));
+				return;
+			}
+
+			UModifierDefinition* Definition = FindDefinition(Args[0]);
+			const FGameplayTag Level = FGameplayTag::RequestGameplayTag(*Args[1], false);
+			if (!Definition || !Level.IsValid())
+			{
+				UE_LOG(LogModifierDefinition, Warning, TEXT("Definition '%s' or level '%s' not found"), *Args[0], *Args[1]);
+				return;
+			}
+
+			if (!Definition->SetParam(Level, *Args[2], Args[3]))
+			{
+				UE_LOG(LogModifierDefinition, Warning, TEXT("Failed to set '%s' of '%s' to '%s'"), *Args[2], *Args[1], *Args[3]);
+			}
+		}));
+
+	static FAutoConsoleCommand RecompileCommand(
+		TEXT("p.Modifier.Recompile"),
+		TEXT("Recompile every loaded modifier definition, and swap every character using them to the new tables."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			for (TObjectIterator<UModifierDefinition> It; It; ++It)
+			{
+				if (!It->HasAnyFlags(RF_ClassDefaultObject))
+				{
+					It->Compile();
+				}
+			}
+		}));
+}
+#endif
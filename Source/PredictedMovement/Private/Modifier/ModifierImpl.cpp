@@ -6,16 +6,24 @@
 #include "Algo/MaxElement.h"
 #include "Algo/MinElement.h"
 
+bool FModifierMoveResponse::Serialize(FArchive& Ar, const FString& ErrorName)
+{
+	Ar << Modifiers;
+	return FModifierStatics::NetSerializeExpiry(Expiry, Modifiers, Ar, MAX_uint8);
+}
+
 bool FModifierMoveData_LocalPredicted::Serialize(FArchive& Ar, const FString& ErrorName,
 	uint8 MaxSerializedModifiers)
 {
-	return FModifierStatics::NetSerialize(WantsModifiers, Ar, ErrorName, MaxSerializedModifiers);
+	return FModifierStatics::NetSerialize(WantsModifiers, Ar, ErrorName, MaxSerializedModifiers) &&
+		FModifierStatics::NetSerializeExpiry(WantsExpiry, WantsModifiers, Ar, MaxSerializedModifiers);
 }
 
 bool FModifierMoveData_WithCorrection::Serialize(FArchive& Ar, const FString& ErrorName,
 	uint8 MaxSerializedModifiers)
 {
 	return FModifierStatics::NetSerialize(WantsModifiers, Ar, ErrorName, MaxSerializedModifiers) &&
+		FModifierStatics::NetSerializeExpiry(WantsExpiry, WantsModifiers, Ar, MaxSerializedModifiers) &&
 		FModifierStatics::NetSerialize(Modifiers, Ar, ErrorName, MaxSerializedModifiers);
 }
 
@@ -24,6 +32,231 @@ bool FModifierMoveData_ServerInitiated::Serialize(FArchive& Ar, const FString& E
 	return FModifierStatics::NetSerialize(Modifiers, Ar, ErrorName, MaxSerializedModifiers);
 }
 
+FModifierHandle FMovementModifier::AddModifier(TModSize Level, float Expiry)
+{
+	if (Expiry < NO_MODIFIER_EXPIRY || WantsExpiry.Num() > 0)
+	{
+		// Once a timed modifier is added, expiry is tracked for every entry
+		while (WantsExpiry.Num() < WantsModifiers.Num())
+		{
+			WantsExpiry.Add(NO_MODIFIER_EXPIRY);
+		}
+		WantsExpiry.Add(Expiry);
+		NextExpiry = FMath::Min(NextExpiry, Expiry);
+	}
+
+	// New modifiers are always added to the end, regardless of slot, so that LimitNumModifiers() evicts the oldest
+	const TModSize Slot = AllocateSlot();
+	WantsModifiers.Add(Level);
+	WantsSlots.Add(Slot);
+
+	return Slot != NO_MODIFIER ? FModifierHandle(Slot, SlotGenerations[Slot]) : FModifierHandle();
+}
+
+bool FMovementModifier::RemoveModifierByHandle(const FModifierHandle& Handle)
+{
+	if (!IsHandleActive(Handle))
+	{
+		return false;
+	}
+
+	// Bounded by the size of the stack, which is kept packed and in order for prediction and eviction
+	const int32 Index = WantsSlots.IndexOfByKey(Handle.Slot);
+	if (!ensure(Index != INDEX_NONE))
+	{
+		return false;
+	}
+
+	RemoveWantedModifierAt(Index);
+	UpdateNextExpiry();
+	return true;
+}
+
+bool FMovementModifier::RemoveModifier(TModSize Level, bool bRemoveAll)
+{
+	bool bRemoved = false;
+	if (bRemoveAll)
+	{
+		for (int32 i = WantsModifiers.Num() - 1; i >= 0; --i)
+		{
+			if (WantsModifiers[i] == Level)
+			{
+				RemoveWantedModifierAt(i);
+				bRemoved = true;
+			}
+		}
+	}
+	else
+	{
+		// Remove the first one found, skipping timed modifiers unless nothing else matches, as they expire on their own
+		int32 Index = INDEX_NONE;
+		for (int32 i = 0; i < WantsModifiers.Num(); ++i)
+		{
+			if (WantsModifiers[i] == Level)
+			{
+				if (WantsExpiry.Num() == 0 || WantsExpiry[i] >= NO_MODIFIER_EXPIRY)
+				{
+					Index = i;
+					break;
+				}
+				if (Index == INDEX_NONE)
+				{
+					Index = i;
+				}
+			}
+		}
+
+		if (Index != INDEX_NONE)
+		{
+			RemoveWantedModifierAt(Index);
+			bRemoved = true;
+		}
+	}
+
+	if (bRemoved)
+	{
+		UpdateNextExpiry();
+	}
+	return bRemoved;
+}
+
+bool FMovementModifier::RemoveExpiredModifiers(float Timestamp)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FMovementModifier::RemoveExpiredModifiers);
+
+	bool bRemoved = false;
+	for (int32 i = WantsExpiry.Num() - 1; i >= 0; --i)
+	{
+		if (WantsExpiry[i] <= Timestamp)
+		{
+			RemoveWantedModifierAt(i);
+			bRemoved = true;
+		}
+	}
+
+	UpdateNextExpiry();
+	return bRemoved;
+}
+
+void FMovementModifier::RemoveWantedModifierAt(int32 Index)
+{
+	WantsModifiers.RemoveAt(Index, 1, EAllowShrinking::No);
+	if (WantsExpiry.Num() > 0)
+	{
+		WantsExpiry.RemoveAt(Index, 1, EAllowShrinking::No);
+	}
+	if (WantsSlots.IsValidIndex(Index))
+	{
+		FreeSlot(WantsSlots[Index]);
+		WantsSlots.RemoveAt(Index, 1, EAllowShrinking::No);
+	}
+}
+
+TModSize FMovementModifier::AllocateSlot()
+{
+	if (FreeSlots.Num() > 0)
+	{
+		return FreeSlots.Pop(EAllowShrinking::No);
+	}
+
+	if (SlotGenerations.Num() < NO_MODIFIER)
+	{
+		return static_cast<TModSize>(SlotGenerations.Add(0));
+	}
+
+	return NO_MODIFIER;
+}
+
+void FMovementModifier::FreeSlot(TModSize Slot)
+{
+	if (SlotGenerations.IsValidIndex(Slot))
+	{
+		++SlotGenerations[Slot];
+		FreeSlots.Add(Slot);
+	}
+}
+
+void FMovementModifier::FreeAllSlots()
+{
+	for (const TModSize Slot : WantsSlots)
+	{
+		FreeSlot(Slot);
+	}
+	WantsSlots.Reset();
+}
+
+void FMovementModifier::RebaseExpiry(float Offset)
+{
+	for (float& Expiry : WantsExpiry)
+	{
+		if (Expiry < NO_MODIFIER_EXPIRY)
+		{
+			Expiry += Offset;
+		}
+	}
+
+	for (float& Expiry : ModifiersExpiry)
+	{
+		if (Expiry < NO_MODIFIER_EXPIRY)
+		{
+			Expiry += Offset;
+		}
+	}
+
+	UpdateNextExpiry();
+}
+
+void FMovementModifier::SetWantsModifiers(const TModifierStack& InWantsModifiers, const TModifierExpiry& InWantsExpiry)
+{
+	if (WantsModifiers != InWantsModifiers || WantsSlots.Num() != WantsModifiers.Num())
+	{
+		// The slots no longer describe these modifiers, so no handle can be trusted to remove the right one
+		FreeAllSlots();
+		WantsModifiers = InWantsModifiers;
+		for (int32 i = 0; i < WantsModifiers.Num(); ++i)
+		{
+			WantsSlots.Add(AllocateSlot());
+		}
+	}
+
+	// Expiry that doesn't line up with the modifiers can't be trusted, treat them as untimed instead
+	if (InWantsExpiry.Num() == InWantsModifiers.Num())
+	{
+		WantsExpiry = InWantsExpiry;
+	}
+	else
+	{
+		WantsExpiry.Reset();
+	}
+
+	UpdateNextExpiry();
+}
+
+void FMovementModifier::RestoreWantsModifiers(const FMovementModifier& From)
+{
+	WantsModifiers = From.WantsModifiers;
+	WantsExpiry = From.WantsExpiry;
+	NextExpiry = From.NextExpiry;
+	WantsSlots = From.WantsSlots;
+	SlotGenerations = From.SlotGenerations;
+	FreeSlots = From.FreeSlots;
+}
+
+void FMovementModifier::UpdateNextExpiry()
+{
+	NextExpiry = NO_MODIFIER_EXPIRY;
+	for (const float Expiry : WantsExpiry)
+	{
+		NextExpiry = FMath::Min(NextExpiry, Expiry);
+	}
+
+	if (NextExpiry == NO_MODIFIER_EXPIRY)
+	{
+		// Nothing left to expire, so there is nothing to send either
+		WantsExpiry.Reset();
+	}
+}
+
 TModSize FMovementModifier::GetNumWantedModifiersByLevel(TModSize Level) const
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FMovementModifier::GetNumWantedModifiersByLevel);
@@ -73,12 +306,20 @@ bool FMovementModifier::UpdateMovementState(bool bAllowedInCurrentState, bool bC
 	
 	// Only update the modifiers if the current state allows it
 	TModifierStack CurrentModifiers = bAllowedInCurrentState ? WantsModifiers : TModifierStack();
+	ModifiersExpiry = bAllowedInCurrentState ? WantsExpiry : TModifierExpiry();
 
 	// Clamp the number of modifiers to the maximum allowed -- this removes old modifiers first
 	// Note: There may be potential for de-sync if client removes server modifiers out of order (cross that bridge when we get there)
 	if (bAllowedInCurrentState && bClampMax)
 	{
+		const int32 NumModifiers = CurrentModifiers.Num();
 		LimitNumModifiers(CurrentModifiers, Remaining);
+
+		// Keep the expiry in line with the modifiers that remain
+		if (ModifiersExpiry.Num() > 0)
+		{
+			ModifiersExpiry.RemoveAt(0, NumModifiers - CurrentModifiers.Num(), EAllowShrinking::No);
+		}
 	}
 
 	// If the modifiers have changed, update the data
@@ -128,6 +369,44 @@ bool FModifierStatics::NetSerialize(TModifierStack& Modifiers, FArchive& Ar, con
 	return !Ar.IsError();
 }
 
+bool FModifierStatics::NetSerializeExpiry(TModifierExpiry& Expiry, const TModifierStack& Modifiers, FArchive& Ar,
+	uint8 MaxSerializedModifiers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::NetSerializeExpiry);
+
+	// Mirrors NetSerialize(), which doesn't serialize the stack if the max is 0
+	if (MaxSerializedModifiers <= 1)
+	{
+		return !Ar.IsError();
+	}
+
+	// Untimed modifiers only cost a single bit
+	uint8 bHasExpiry = Expiry.Num() > 0 && Expiry.Num() == Modifiers.Num();
+	Ar.SerializeBits(&bHasExpiry, 1);
+	if (!bHasExpiry)
+	{
+		if (Ar.IsLoading())
+		{
+			Expiry.Reset();
+		}
+		return !Ar.IsError();
+	}
+
+	// Modifiers has already been serialized, and was truncated to the same length if saving
+	const int32 NumExpiry = FMath::Min<int32>(Modifiers.Num(), MaxSerializedModifiers);
+	if (Ar.IsLoading())
+	{
+		Expiry.SetNumUninitialized(NumExpiry);
+	}
+
+	for (int32 i = 0; i < NumExpiry; ++i)
+	{
+		Ar << Expiry[i];
+	}
+
+	return !Ar.IsError();
+}
+
 TModSize FModifierStatics::UpdateModifierLevel(EModifierLevelMethod Method, const TModifierStack& Modifiers,
 	TModSize MaxLevel, TModSize InvalidLevel)
 {
@@ -184,7 +463,7 @@ TModSize FModifierStatics::UpdateModifierLevel(EModifierLevelMethod Method, cons
 	return FMath::Clamp(NewLevel, 0, MaxLevel);
 }
 
-TModSize FModifierStatics::CombineModifierLevels(EModifierLevelMethod Method, const TModifierStack& ModifierLevels,
+TModSize FModifierStatics::CombineModifierLevels(EModifierLevelMethod Method, TArrayView<const TModSize> ModifierLevels,
 	TModSize MaxLevel, TModSize InvalidLevel)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::CombineModifierLevels);
@@ -242,6 +521,14 @@ TModSize FModifierStatics::CombineModifierLevels(EModifierLevelMethod Method, co
 bool FModifierStatics::ProcessModifiers(TModSize& CurrentLevel, EModifierLevelMethod Method,
 	const TArray<FGameplayTag>& LevelTags, bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,
 	const TArray<FMovementModifier*>& Modifiers, const TFunctionRef<bool()>& CanActivateCallback)
+{
+	return ProcessModifiers(CurrentLevel, Method, LevelTags, bLimitMaxModifiers, MaxModifiers, InvalidLevel,
+		MakeArrayView(Modifiers), CanActivateCallback());
+}
+
+bool FModifierStatics::ProcessModifiers(TModSize& CurrentLevel, EModifierLevelMethod Method,
+	const TArray<FGameplayTag>& LevelTags, bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,
+	TArrayView<FMovementModifier* const> Modifiers, bool bCanActivate)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::ProcessModifiers);
 	
@@ -252,14 +539,14 @@ bool FModifierStatics::ProcessModifiers(TModSize& CurrentLevel, EModifierLevelMe
 
 	// Track modifier data
 	bool bStateChanged = false;
-	TArray<TModSize> Levels;
+	TArray<TModSize, TInlineAllocator<8>> Levels;
 	int32 Remaining = MaxModifiers;
 
 	// Iterate through all modifiers and update their state
 	for (FMovementModifier* Modifier : Modifiers)
 	{
 		// Track if any state changed
-		bStateChanged |= Modifier->UpdateMovementState(CanActivateCallback(), bLimitMaxModifiers, Remaining);
+		bStateChanged |= Modifier->UpdateMovementState(bCanActivate, bLimitMaxModifiers, Remaining);
 
 		// Always read and process the current modifier data
 		const TModSize NewLevel = UpdateModifierLevel(Method, Modifier->Modifiers, MaxLevel, InvalidLevel);
@@ -0,0 +1,159 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierLibrary.h"
+
+#include "Modifier/ModifierCharacter.h"
+#include "Modifier/ModifierMovement.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierLibrary)
+
+namespace ModifierLibrary
+{
+	/**
+	 * @return True if the server can change NetType modifiers on Character
+	 * A remote client sends its own predicted modifiers with each move, overwriting any the server added
+	 */
+	static bool CanModifyFromServer(const AModifierCharacter* Character, EModifierNetType NetType)
+	{
+		return Character->HasAuthority() && (NetType == EModifierNetType::ServerInitiated || Character->IsLocallyControlled());
+	}
+
+	/** Call Func for every AModifierCharacter in Targets that has a UModifierMovement */
+	template<typename TFunc>
+	void ForEachCharacter(const TArray<AActor*>& Targets, TFunc&& Func)
+	{
+		for (AActor* Target : Targets)
+		{
+			AModifierCharacter* Character = Cast<AModifierCharacter>(Target);
+			UModifierMovement* MoveComp = Character ? Character->GetCharacterMovement<UModifierMovement>() : nullptr;
+			if (MoveComp)
+			{
+				Func(Character, MoveComp);
+			}
+		}
+	}
+}
+
+int32 UModifierLibrary::BoostCharacters(const TArray<AActor*>& Targets, FGameplayTag Level, EModifierNetType NetType,
+	float Duration, TArray<AModifierCharacter*>& Changed, TArray<FModifierHandle>& Handles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierLibrary::BoostCharacters);
+
+	Changed.Reset(Targets.Num());
+	Handles.Reset(Targets.Num());
+	if (!Level.IsValid())
+	{
+		return 0;
+	}
+
+	uint8 CachedIndex = NO_MODIFIER;
+	ModifierLibrary::ForEachCharacter(Targets, [&](AModifierCharacter* Character, UModifierMovement* MoveComp)
+	{
+		if (!ModifierLibrary::CanModifyFromServer(Character, NetType))
+		{
+			return;
+		}
+		const uint8 LevelIndex = ResolveLevelIndex(MoveComp->GetBoostLevels(), Level, CachedIndex);
+		const FModifierHandle Handle = Character->BoostByIndex(LevelIndex, NetType, Duration);
+		if (Handle.IsValid())
+		{
+			Changed.Add(Character);
+			Handles.Add(Handle);
+		}
+	});
+	return Changed.Num();
+}
+
+int32 UModifierLibrary::UnBoostCharacters(const TArray<AActor*>& Targets, FGameplayTag Level, EModifierNetType NetType,
+	bool bRemoveAll, TArray<AModifierCharacter*>& Changed)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierLibrary::UnBoostCharacters);
+
+	Changed.Reset(Targets.Num());
+	if (!Level.IsValid())
+	{
+		return 0;
+	}
+
+	uint8 CachedIndex = NO_MODIFIER;
+	ModifierLibrary::ForEachCharacter(Targets, [&](AModifierCharacter* Character, UModifierMovement* MoveComp)
+	{
+		if (!ModifierLibrary::CanModifyFromServer(Character, NetType))
+		{
+			return;
+		}
+		const uint8 LevelIndex = ResolveLevelIndex(MoveComp->GetBoostLevels(), Level, CachedIndex);
+		if (Character->UnBoostByIndex(LevelIndex, NetType, bRemoveAll))
+		{
+			Changed.Add(Character);
+		}
+	});
+	return Changed.Num();
+}
+
+int32 UModifierLibrary::SnareCharacters(const TArray<AActor*>& Targets, FGameplayTag Level, float Duration,
+	TArray<AModifierCharacter*>& Changed, TArray<FModifierHandle>& Handles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierLibrary::SnareCharacters);
+
+	Changed.Reset(Targets.Num());
+	Handles.Reset(Targets.Num());
+	if (!Level.IsValid())
+	{
+		return 0;
+	}
+
+	uint8 CachedIndex = NO_MODIFIER;
+	ModifierLibrary::ForEachCharacter(Targets, [&](AModifierCharacter* Character, UModifierMovement* MoveComp)
+	{
+		const uint8 LevelIndex = ResolveLevelIndex(MoveComp->GetSnareLevels(), Level, CachedIndex);
+		const FModifierHandle Handle = Character->SnareByIndex(LevelIndex, Duration);
+		if (Handle.IsValid())
+		{
+			Changed.Add(Character);
+			Handles.Add(Handle);
+		}
+	});
+	return Changed.Num();
+}
+
+int32 UModifierLibrary::UnSnareCharacters(const TArray<AActor*>& Targets, FGameplayTag Level, bool bRemoveAll,
+	TArray<AModifierCharacter*>& Changed)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierLibrary::UnSnareCharacters);
+
+	Changed.Reset(Targets.Num());
+	if (!Level.IsValid())
+	{
+		return 0;
+	}
+
+	uint8 CachedIndex = NO_MODIFIER;
+	ModifierLibrary::ForEachCharacter(Targets, [&](AModifierCharacter* Character, UModifierMovement* MoveComp)
+	{
+		const uint8 LevelIndex = ResolveLevelIndex(MoveComp->GetSnareLevels(), Level, CachedIndex);
+		if (Character->UnSnareByIndex(LevelIndex, bRemoveAll))
+		{
+			Changed.Add(Character);
+		}
+	});
+	return Changed.Num();
+}
+
+uint8 UModifierLibrary::ResolveLevelIndex(const TArray<FGameplayTag>& Levels, const FGameplayTag& Level, uint8& CachedIndex)
+{
+	if (Levels.IsValidIndex(CachedIndex) && Levels[CachedIndex] == Level)
+	{
+		return CachedIndex;
+	}
+
+	// Different level tables, or the first character
+	const int32 Index = Levels.IndexOfByKey(Level);
+	if (Index != INDEX_NONE)
+	{
+		CachedIndex = static_cast<uint8>(Index);
+		return CachedIndex;
+	}
+	return NO_MODIFIER;
+}
@@ -5,7 +5,11 @@
 
 #include "Modifier/ModifierCharacter.h"
 #include "Modifier/ModifierTags.h"
+#include "System/PredictedMovementStats.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/GameNetworkManager.h"
+#include "GameFramework/PlayerController.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
 
 #if WITH_EDITOR
 #include "Misc/DataValidation.h"
@@ -15,6 +19,10 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogModifierMovement, Log, All);
 
+DECLARE_MEMORY_STAT(TEXT("Modifier Tables (Owned)"), STAT_ModifierTablesOwned, STATGROUP_PredictedMovement);
+DECLARE_MEMORY_STAT(TEXT("Modifier Tables (Saved by Sharing)"), STAT_ModifierTablesSaved, STATGROUP_PredictedMovement);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Client Auth Distance Scale"), STAT_ClientAuthDistanceScale, STATGROUP_PredictedMovement);
+
 namespace ModifierMovementCVars
 {
 #if !UE_BUILD_SHIPPING
@@ -34,6 +42,8 @@ UModifierMovement::UModifierMovement(const FObjectInitializer& ObjectInitializer
 	SetNetworkMoveDataContainer(ModifierMoveDataContainer);
 	SetMoveResponseDataContainer(ModifierMoveResponseDataContainer);
 
+	ModifierTables = FModifierTables::GetEmpty();
+
 	// Init Modifier Levels
 	Boost.Add(FModifierTags::Modifier_Boost, { 1.50f });  // 50% Speed Boost
 	Snare.Add(FModifierTags::Modifier_Snare, { 0.50f });  // 50% Speed Snare
@@ -57,9 +67,9 @@ void FModifierMoveResponseDataContainer::ServerFillResponseData(const UCharacter
 	const UModifierMovement* MoveComp = Cast<UModifierMovement>(&CharacterMovement);
 
 	// Fill the response data with the current modifier state
-	BoostCorrection.ServerFillResponseData(MoveComp->BoostCorrection.Modifiers);
-	BoostServer.ServerFillResponseData(MoveComp->BoostServer.Modifiers);
-	SnareServer.ServerFillResponseData(MoveComp->SnareServer.Modifiers);
+	BoostCorrection.ServerFillResponseData(MoveComp->BoostCorrection.Modifiers, MoveComp->BoostCorrection.ModifiersExpiry);
+	BoostServer.ServerFillResponseData(MoveComp->BoostServer.Modifiers, MoveComp->BoostServer.ModifiersExpiry);
+	SnareServer.ServerFillResponseData(MoveComp->SnareServer.Modifiers, MoveComp->SnareServer.ModifiersExpiry);
 
 	// Fill ClientAuthAlpha
 	ClientAuthAlpha = MoveComp->ClientAuthAlpha;
@@ -77,10 +87,10 @@ bool FModifierMoveResponseDataContainer::Serialize(UCharacterMovementComponent&
 	// Server ➜ Client
 	if (IsCorrection())
 	{
-		// Serialize Modifiers
-		Ar << BoostCorrection.Modifiers;
-		Ar << BoostServer.Modifiers;
-		Ar << SnareServer.Modifiers;
+		// Serialize Modifiers, and when they expire so the client can expire them without another correction
+		BoostCorrection.Serialize(Ar, TEXT("BoostCorrection"));
+		BoostServer.Serialize(Ar, TEXT("BoostServer"));
+		SnareServer.Serialize(Ar, TEXT("SnareServer"));
 
 		// Serialize ClientAuthAlpha
 		Ar.SerializeBits(&bHasClientAuthAlpha, 1);
@@ -113,11 +123,11 @@ void FModifierNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Charac
 	const FSavedMove_Character_Modifier& SavedMove = static_cast<const FSavedMove_Character_Modifier&>(ClientMove);
 
 	// Fill the Modifier data from the saved move
-	BoostLocal.ClientFillNetworkMoveData(SavedMove.BoostLocal.WantsModifiers);
-	BoostCorrection.ClientFillNetworkMoveData(SavedMove.BoostCorrection.WantsModifiers, SavedMove.BoostCorrection.Modifiers);
+	BoostLocal.ClientFillNetworkMoveData(SavedMove.BoostLocal.WantsModifiers, SavedMove.BoostLocal.WantsExpiry);
+	BoostCorrection.ClientFillNetworkMoveData(SavedMove.BoostCorrection.WantsModifiers, SavedMove.BoostCorrection.WantsExpiry, SavedMove.BoostCorrection.Modifiers);
 	BoostServer.ClientFillNetworkMoveData(SavedMove.BoostServer.Modifiers);
 	SnareServer.ClientFillNetworkMoveData(SavedMove.SnareServer.Modifiers);
-	SlowFallLocal.ClientFillNetworkMoveData(SavedMove.SlowFallLocal.WantsModifiers);
+	SlowFallLocal.ClientFillNetworkMoveData(SavedMove.SlowFallLocal.WantsModifiers, SavedMove.SlowFallLocal.WantsExpiry);
 }
 
 bool FModifierNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
@@ -147,13 +157,71 @@ void UModifierMovement::PostLoad()
 	ModifierCharacterOwner = Cast<AModifierCharacter>(PawnOwner);
 }
 
+void UModifierMovement::OnRegister()
+{
+	Super::OnRegister();
+
+	BuildModifierLevels();
+}
+
+void UModifierMovement::OnUnregister()
+{
+	UnbindModifierDefinition();
+
+	DEC_MEMORY_STAT_BY(STAT_ModifierTablesOwned, ModifierTablesOwnedSize);
+	DEC_MEMORY_STAT_BY(STAT_ModifierTablesSaved, ModifierTablesSavedSize);
+	ModifierTablesOwnedSize = 0;
+	ModifierTablesSavedSize = 0;
+
+	Super::OnUnregister();
+}
+
+void UModifierMovement::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Replicate any simulated modifier levels that changed this frame or are waiting on their hold time
+	if (ModifierCharacterOwner && ModifierCharacterOwner->HasAuthority())
+	{
+		ModifierCharacterOwner->FlushSimulatedModifierLevels();
+	}
+	else if (ModifierCharacterOwner && ModifierCharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+	{
+		ModifierCharacterOwner->UpdateProxyModifierLOD();
+	}
+}
+
 void UModifierMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
 {
+	if (PawnOwner)
+	{
+		PawnOwner->ReceiveControllerChangedDelegate.RemoveDynamic(this, &ThisClass::OnPawnControllerChanged);
+	}
+
 	Super::SetUpdatedComponent(NewUpdatedComponent);
 
 	ModifierCharacterOwner = Cast<AModifierCharacter>(PawnOwner);
+
+	if (PawnOwner)
+	{
+		PawnOwner->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &ThisClass::OnPawnControllerChanged);
+	}
+}
+
+void UModifierMovement::OnPawnControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	AdaptiveClientAuthState.Reset();
 }
 
+#if WITH_EDITOR
+void UModifierMovement::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BuildModifierLevels();
+}
+#endif
+
 float UModifierMovement::GetMaxAcceleration() const
 {
 	return Super::GetMaxAcceleration() * GetBoostAccelScalar() * GetSnareAccelScalar();
@@ -261,6 +329,171 @@ bool UModifierMovement::RemoveVelocityZOnSlowFallStart() const
 	return false;
 }
 
+float UModifierMovement::GetModifierTimestamp() const
+{
+	if (ReplayingMoveTimestamp >= 0.f)
+	{
+		// Client replaying a saved move
+		return ReplayingMoveTimestamp;
+	}
+
+	if (CharacterOwner->GetLocalRole() == ROLE_Authority)
+	{
+		if (CharacterOwner->IsLocallyControlled())
+		{
+			// Server owned character
+			return GetWorld()->GetTimeSeconds();
+		}
+		else
+		{
+			// Server remote character
+			const FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+			return ServerData->CurrentClientTimeStamp;
+		}
+	}
+	else
+	{
+		// Client owned character
+		const FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+		return ClientData->CurrentTimeStamp;
+	}
+}
+
+float UModifierMovement::GetModifierExpiry(float Duration) const
+{
+	return Duration > 0.f && HasValidData() ? GetModifierTimestamp() + Duration : NO_MODIFIER_EXPIRY;
+}
+
+void UModifierMovement::ExpireModifiers()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::ExpireModifiers);
+
+	const float Timestamp = GetModifierTimestamp();
+
+	// Client timestamps are reset periodically to retain precision, move the expiry back along with them
+	// Client and server both see the same reset, so they rebase identically
+	const bool bTimestampReset = Timestamp < LastModifierTimestamp - MinTimeBetweenTimeStampResets * 0.5f;
+	LastModifierTimestamp = Timestamp;
+
+	FMovementModifier* Modifiers[] = { &BoostLocal, &BoostCorrection, &BoostServer, &SnareServer, &SlowFallLocal };
+	for (FMovementModifier* Modifier : Modifiers)
+	{
+		if (bTimestampReset)
+		{
+			Modifier->RebaseExpiry(-MinTimeBetweenTimeStampResets);
+		}
+		Modifier->ExpireModifiers(Timestamp);
+	}
+}
+
+void UModifierMovement::UpdateZoneModifiers()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::UpdateZoneModifiers);
+
+	TModifierStack Boosts;
+	TModifierStack Snares;
+	TModifierStack SlowFalls;
+
+	const UModifierZoneSubsystem* ZoneSubsystem = bEnableModifierZones ? GetWorld()->GetSubsystem<UModifierZoneSubsystem>() : nullptr;
+	if (ZoneSubsystem && ZoneSubsystem->GetNumZones() > 0)
+	{
+		ZoneSubsystem->GetZonesAtLocation(UpdatedComponent->GetComponentLocation(), ZoneQuery);
+		for (const FModifierZone* Zone : ZoneQuery)
+		{
+			if (Zone->ModifierType == FModifierTags::Modifier_Boost)
+			{
+				const uint8 Level = GetBoostLevelIndex(Zone->Level);
+				if (Level != NO_MODIFIER) { Boosts.Add(Level); }
+			}
+			else if (Zone->ModifierType == FModifierTags::Modifier_Snare)
+			{
+				const uint8 Level = GetSnareLevelIndex(Zone->Level);
+				if (Level != NO_MODIFIER) { Snares.Add(Level); }
+			}
+			else if (Zone->ModifierType == FModifierTags::Modifier_SlowFall)
+			{
+				const uint8 Level = GetSlowFallLevelIndex(Zone->Level);
+				if (Level != NO_MODIFIER) { SlowFalls.Add(Level); }
+			}
+		}
+		ZoneQuery.Reset();
+
+		// Zone registration order can differ between Client and Server, the result must not
+		Boosts.Sort();
+		Snares.Sort();
+		SlowFalls.Sort();
+	}
+
+	BoostZone.WantsModifiers = MoveTemp(Boosts);
+	SnareZone.WantsModifiers = MoveTemp(Snares);
+	SlowFallZone.WantsModifiers = MoveTemp(SlowFalls);
+}
+
+UPhysicalMaterial* UModifierMovement::GetFloorPhysicalMaterial() const
+{
+	if (!IsMovingOnGround() || !CurrentFloor.IsWalkableFloor())
+	{
+		return nullptr;
+	}
+
+	if (UPhysicalMaterial* PhysMaterial = CurrentFloor.HitResult.PhysMaterial.Get())
+	{
+		return PhysMaterial;
+	}
+
+	// Floor queries don't request the physical material, fall back to the floor's simple collision material
+	const UPrimitiveComponent* Floor = CurrentFloor.HitResult.GetComponent();
+	const FBodyInstance* BodyInstance = Floor ? Floor->GetBodyInstance() : nullptr;
+	return BodyInstance ? BodyInstance->GetSimplePhysicalMaterial() : nullptr;
+}
+
+void UModifierMovement::UpdateSurfaceModifiers()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::UpdateSurfaceModifiers);
+
+	if (SurfaceModifiers.Num() == 0)
+	{
+		BoostSurface.WantsModifiers.Reset();
+		SnareSurface.WantsModifiers.Reset();
+		return;
+	}
+
+	const UPrimitiveComponent* Floor = IsMovingOnGround() ? CurrentFloor.HitResult.GetComponent() : nullptr;
+	UPhysicalMaterial* PhysMaterial = GetFloorPhysicalMaterial();
+
+	// Only resolve the surface when the floor changes
+	if (bSurfaceCached && SurfaceCacheComponent.Get() == Floor && SurfaceCacheMaterial.Get() == PhysMaterial)
+	{
+		return;
+	}
+
+	SurfaceCacheComponent = Floor;
+	SurfaceCacheMaterial = PhysMaterial;
+	SurfaceCacheType = FGameplayTag::EmptyTag;
+	SurfaceCacheLevel = NO_MODIFIER;
+	bSurfaceCached = true;
+
+	const FGameplayTag* Level = PhysMaterial ? SurfaceModifiers.Find(PhysMaterial) : nullptr;
+	if (Level && Level->MatchesTag(FModifierTags::Modifier_Boost))
+	{
+		SurfaceCacheType = FModifierTags::Modifier_Boost;
+		SurfaceCacheLevel = GetBoostLevelIndex(*Level);
+	}
+	else if (Level && Level->MatchesTag(FModifierTags::Modifier_Snare))
+	{
+		SurfaceCacheType = FModifierTags::Modifier_Snare;
+		SurfaceCacheLevel = GetSnareLevelIndex(*Level);
+	}
+
+	BoostSurface.WantsModifiers.Reset();
+	SnareSurface.WantsModifiers.Reset();
+	if (SurfaceCacheLevel != NO_MODIFIER)
+	{
+		TMod_Zone& Surface = SurfaceCacheType == FModifierTags::Modifier_Boost ? BoostSurface : SnareSurface;
+		Surface.WantsModifiers.Add(SurfaceCacheLevel);
+	}
+}
+
 void UModifierMovement::ProcessModifierMovementState()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::ProcessModifierMovementState);
@@ -273,8 +506,8 @@ void UModifierMovement::ProcessModifierMovementState()
 		{	// Boost
 			const FGameplayTag PrevBoostLevel = GetBoostLevel();
 			const uint8 PrevBoostLevelValue = BoostLevel;
-			const TArray<FMovementModifier*> Boosts = { &BoostLocal, &BoostCorrection, &BoostServer };
-			if (FModifierStatics::ProcessModifiers(BoostLevel, BoostLevelMethod, BoostLevels,
+			const TArray<FMovementModifier*> Boosts = { &BoostLocal, &BoostCorrection, &BoostServer, &BoostZone, &BoostSurface };
+			if (FModifierStatics::ProcessModifiers(BoostLevel, BoostLevelMethod, GetBoostLevels(),
 				bLimitMaxBoosts, MaxBoosts, NO_MODIFIER, Boosts,
 				[this] { return CanBoostInCurrentState(); }))
 			{
@@ -287,8 +520,8 @@ void UModifierMovement::ProcessModifierMovementState()
 		{	// Snare
 			const FGameplayTag PrevSnareLevel = GetSnareLevel();
 			const uint8 PrevSnareLevelValue = SnareLevel;
-			const TArray<FMovementModifier*> Snares = { &SnareServer };
-			if (FModifierStatics::ProcessModifiers(SnareLevel, SnareLevelMethod, SnareLevels,
+			const TArray<FMovementModifier*> Snares = { &SnareServer, &SnareZone, &SnareSurface };
+			if (FModifierStatics::ProcessModifiers(SnareLevel, SnareLevelMethod, GetSnareLevels(),
 				bLimitMaxSnares, MaxSnares, NO_MODIFIER, Snares,
 				[this] { return CanSnareInCurrentState(); }))
 			{
@@ -301,8 +534,8 @@ void UModifierMovement::ProcessModifierMovementState()
 		{	// SlowFall
 			const FGameplayTag PrevSlowFallLevel = GetSlowFallLevel();
 			const uint8 PrevSlowFallLevelValue = SlowFallLevel;
-			const TArray<FMovementModifier*> SlowFalls = { &SlowFallLocal };
-			if (FModifierStatics::ProcessModifiers(SlowFallLevel, SlowFallLevelMethod, SlowFallLevels,
+			const TArray<FMovementModifier*> SlowFalls = { &SlowFallLocal, &SlowFallZone };
+			if (FModifierStatics::ProcessModifiers(SlowFallLevel, SlowFallLevelMethod, GetSlowFallLevels(),
 				bLimitMaxSlowFalls, MaxSlowFalls, NO_MODIFIER, SlowFalls,
 				[this] { return CanSlowFallInCurrentState(); }))
 			{
@@ -314,6 +547,298 @@ void UModifierMovement::ProcessModifierMovementState()
 	}
 }
 
+bool UModifierMovement::IsAIFastPath() const
+{
+	return bEnableAIFastPath && CharacterOwner->GetLocalRole() == ROLE_Authority && !CharacterOwner->IsPlayerControlled();
+}
+
+float UModifierMovement::GetAIModifierUpdateInterval() const
+{
+	if (AIThrottleDistance <= 0.f)
+	{
+		return 0.f;
+	}
+
+	// Update every tick while near any player
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const float ThrottleDistanceSq = FMath::Square(AIThrottleDistance);
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (Pawn && FVector::DistSquared(Pawn->GetActorLocation(), Location) < ThrottleDistanceSq)
+		{
+			return 0.f;
+		}
+	}
+
+	return AIThrottledUpdateInterval;
+}
+
+void UModifierMovement::UpdateAIModifierMovementState(float DeltaSeconds)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::UpdateAIModifierMovementState);
+
+	// Throttle by distance or significance
+	AIModifierUpdateTime += DeltaSeconds;
+	if (AIModifierUpdateTime < AIModifierUpdateInterval)
+	{
+		return;
+	}
+	AIModifierUpdateTime = 0.f;
+	AIModifierUpdateInterval = GetAIModifierUpdateInterval();
+
+	ExpireModifiers();
+	UpdateZoneModifiers();
+	UpdateSurfaceModifiers();
+
+	// Same levels as ProcessModifierMovementState(), without the per-family arrays or callbacks
+	{	// Boost
+		const uint8 PrevBoostLevel = BoostLevel;
+		FMovementModifier* Boosts[] = { &BoostLocal, &BoostCorrection, &BoostServer, &BoostZone, &BoostSurface };
+		if (FModifierStatics::ProcessModifiers(BoostLevel, BoostLevelMethod, GetBoostLevels(),
+			bLimitMaxBoosts, MaxBoosts, NO_MODIFIER, Boosts, CanBoostInCurrentState()))
+		{
+			NotifyAIModifierChanged(FModifierTags::Modifier_Boost, GetBoostLevels(), BoostLevel, PrevBoostLevel);
+		}
+	}
+
+	{	// Snare
+		const uint8 PrevSnareLevel = SnareLevel;
+		FMovementModifier* Snares[] = { &SnareServer, &SnareZone, &SnareSurface };
+		if (FModifierStatics::ProcessModifiers(SnareLevel, SnareLevelMethod, GetSnareLevels(),
+			bLimitMaxSnares, MaxSnares, NO_MODIFIER, Snares, CanSnareInCurrentState()))
+		{
+			NotifyAIModifierChanged(FModifierTags::Modifier_Snare, GetSnareLevels(), SnareLevel, PrevSnareLevel);
+		}
+	}
+
+	{	// SlowFall
+		const uint8 PrevSlowFallLevel = SlowFallLevel;
+		FMovementModifier* SlowFalls[] = { &SlowFallLocal, &SlowFallZone };
+		if (FModifierStatics::ProcessModifiers(SlowFallLevel, SlowFallLevelMethod, GetSlowFallLevels(),
+			bLimitMaxSlowFalls, MaxSlowFalls, NO_MODIFIER, SlowFalls, CanSlowFallInCurrentState()))
+		{
+			NotifyAIModifierChanged(FModifierTags::Modifier_SlowFall, GetSlowFallLevels(), SlowFallLevel, PrevSlowFallLevel);
+		}
+	}
+}
+
+void UModifierMovement::NotifyAIModifierChanged(const FGameplayTag& ModifierType, const TArray<FGameplayTag>& Levels,
+	uint8 Level, uint8 PrevLevel) const
+{
+	// Called whenever the modifiers change, even if the level doesn't, to match ProcessModifierMovementState()
+	if (bAIFastPathSuppressEvents)
+	{
+		ModifierCharacterOwner->SetSimulatedModifierLevel(ModifierType, Level);
+	}
+	else
+	{
+		const FGameplayTag LevelTag = Levels.IsValidIndex(Level) ? Levels[Level] : FGameplayTag::EmptyTag;
+		const FGameplayTag PrevLevelTag = Levels.IsValidIndex(PrevLevel) ? Levels[PrevLevel] : FGameplayTag::EmptyTag;
+		ModifierCharacterOwner->NotifyModifierChanged<uint8>(ModifierType, LevelTag, PrevLevelTag, Level, PrevLevel, NO_MODIFIER);
+	}
+}
+
+void UModifierMovement::BuildModifierLevels()
+{
+	DEC_MEMORY_STAT_BY(STAT_ModifierTablesOwned, ModifierTablesOwnedSize);
+	DEC_MEMORY_STAT_BY(STAT_ModifierTablesSaved, ModifierTablesSavedSize);
+	ModifierTablesOwnedSize = 0;
+	ModifierTablesSavedSize = 0;
+	OverriddenModifierParams.Reset();
+
+	if (ModifierDefinition)
+	{
+		// Shared with every other character using this definition
+		ModifierTables = ModifierDefinition->GetTables();
+		bOwnsModifierTables = false;
+
+		// Follow the definition if it is recompiled at runtime
+		if (BoundModifierDefinition != ModifierDefinition)
+		{
+			UnbindModifierDefinition();
+			BoundModifierDefinition = ModifierDefinition;
+			ModifierDefinitionChangedHandle = ModifierDefinition->OnTablesChanged.AddUObject(this, &ThisClass::OnModifierDefinitionChanged);
+		}
+
+		// Our own maps are unused, free them, keeping them in the editor so they aren't lost
+		const SIZE_T MapsSize = Boost.GetAllocatedSize() + Snare.GetAllocatedSize() + SlowFall.GetAllocatedSize() + ClientAuthParams.GetAllocatedSize();
+		if (GetWorld() && GetWorld()->IsGameWorld())
+		{
+			Boost.Empty();
+			Snare.Empty();
+			SlowFall.Empty();
+			ClientAuthParams.Empty();
+		}
+		ModifierTablesSavedSize = ModifierTables->GetAllocatedSize() + MapsSize;
+	}
+	else
+	{
+		UnbindModifierDefinition();
+		ModifierTables = FModifierTables::Build(Boost, Snare, SlowFall, ClientAuthParams);
+		bOwnsModifierTables = true;
+		ModifierTablesOwnedSize = ModifierTables->GetAllocatedSize();
+	}
+
+	INC_MEMORY_STAT_BY(STAT_ModifierTablesOwned, ModifierTablesOwnedSize);
+	INC_MEMORY_STAT_BY(STAT_ModifierTablesSaved, ModifierTablesSavedSize);
+
+	// Cached levels refer to the previous indexes
+	RefreshSurfaceModifiers();
+}
+
+FModifierTables& UModifierMovement::GetMutableModifierTables()
+{
+	if (!bOwnsModifierTables)
+	{
+		// Copy on write, so the shared tables are unaffected
+		ModifierTables = MakeShared<FModifierTables>(*ModifierTables);
+		bOwnsModifierTables = true;
+
+		DEC_MEMORY_STAT_BY(STAT_ModifierTablesSaved, ModifierTablesSavedSize);
+		ModifierTablesSavedSize = 0;
+		ModifierTablesOwnedSize = ModifierTables->GetAllocatedSize();
+		INC_MEMORY_STAT_BY(STAT_ModifierTablesOwned, ModifierTablesOwnedSize);
+	}
+
+	// We are the only owner
+	return const_cast<FModifierTables&>(*ModifierTables);
+}
+
+void UModifierMovement::UnbindModifierDefinition()
+{
+	if (UModifierDefinition* Definition = BoundModifierDefinition.Get())
+	{
+		Definition->OnTablesChanged.Remove(ModifierDefinitionChangedHandle);
+	}
+	BoundModifierDefinition.Reset();
+	ModifierDefinitionChangedHandle.Reset();
+}
+
+void UModifierMovement::OnModifierDefinitionChanged()
+{
+	if (!ModifierDefinition)
+	{
+		return;
+	}
+
+	const TSharedRef<const FModifierTables> NewTables = ModifierDefinition->GetTables();
+	const bool bLevelsChanged = NewTables->Checksum != GetModifierLevelsChecksum();
+
+	if (!bLevelsChanged && OverriddenModifierParams.Num() == 0)
+	{
+		// Swap in one assignment, the previous tables are released once nothing references them
+		BuildModifierLevels();
+	}
+	else
+	{
+		if (bLevelsChanged)
+		{
+			// Active modifiers, replicated levels and saved moves hold indexes into our levels, which must not change
+			UE_LOG(LogModifierMovement, Warning, TEXT("%s: Modifier levels changed while in use, only params were reloaded, level changes apply once the character is recreated"),
+				*GetNameSafe(CharacterOwner));
+		}
+
+		// Keep our levels and overrides, taking everything else from the new tables
+		DEC_MEMORY_STAT_BY(STAT_ModifierTablesOwned, ModifierTablesOwnedSize);
+		DEC_MEMORY_STAT_BY(STAT_ModifierTablesSaved, ModifierTablesSavedSize);
+		ModifierTables = FModifierTables::MergeParams(*ModifierTables, *NewTables, OverriddenModifierParams);
+		bOwnsModifierTables = true;
+		ModifierTablesOwnedSize = ModifierTables->GetAllocatedSize();
+		ModifierTablesSavedSize = 0;
+		INC_MEMORY_STAT_BY(STAT_ModifierTablesOwned, ModifierTablesOwnedSize);
+	}
+
+	// Let the other side know, so that a reload on only one of them is reported
+	if (CharacterOwner && CharacterOwner->HasAuthority() && !CharacterOwner->IsLocallyControlled() && CharacterOwner->GetNetConnection())
+	{
+		ClientVerifyModifierLevels(GetModifierLevelsChecksum(), GetModifierTablesVersion());
+	}
+	else
+	{
+		VerifyModifierLevels();
+	}
+}
+
+bool UModifierMovement::OverrideBoostParams(FGameplayTag Level, const FMovementModifierParams& Params)
+{
+	const uint8 LevelIndex = GetBoostLevelIndex(Level);
+	if (LevelIndex == NO_MODIFIER)
+	{
+		return false;
+	}
+	GetMutableModifierTables().BoostParams[LevelIndex] = Params;
+	OverriddenModifierParams.Add(Level);
+	return true;
+}
+
+bool UModifierMovement::OverrideSnareParams(FGameplayTag Level, const FMovementModifierParams& Params)
+{
+	const uint8 LevelIndex = GetSnareLevelIndex(Level);
+	if (LevelIndex == NO_MODIFIER)
+	{
+		return false;
+	}
+	GetMutableModifierTables().SnareParams[LevelIndex] = Params;
+	OverriddenModifierParams.Add(Level);
+	return true;
+}
+
+bool UModifierMovement::OverrideSlowFallParams(FGameplayTag Level, const FFallingModifierParams& Params)
+{
+	const uint8 LevelIndex = GetSlowFallLevelIndex(Level);
+	if (LevelIndex == NO_MODIFIER)
+	{
+		return false;
+	}
+	OverriddenModifierParams.Add(Level);
+	FFallingModifierParams& SlowFallParams = GetMutableModifierTables().SlowFallParams[LevelIndex];
+	SlowFallParams = Params;
+	SlowFallParams.BakeGravityScalarTable();
+	return true;
+}
+
+void UModifierMovement::OverrideClientAuthParams(FGameplayTag Source, const FClientAuthParams& Params)
+{
+	GetMutableModifierTables().ClientAuthParams.Add(Source, Params);
+	OverriddenModifierParams.Add(Source);
+}
+
+void UModifierMovement::VerifyModifierLevels()
+{
+	if (CharacterOwner && !CharacterOwner->HasAuthority() && CharacterOwner->IsLocallyControlled())
+	{
+		ServerVerifyModifierLevels(GetModifierLevelsChecksum(), GetModifierTablesVersion());
+	}
+}
+
+void UModifierMovement::ServerVerifyModifierLevels_Implementation(uint32 ClientChecksum, uint32 ClientVersion)
+{
+	CompareModifierTables(ClientChecksum, ClientVersion, TEXT("client"));
+}
+
+void UModifierMovement::ClientVerifyModifierLevels_Implementation(uint32 ServerChecksum, uint32 ServerVersion)
+{
+	CompareModifierTables(ServerChecksum, ServerVersion, TEXT("server"));
+}
+
+void UModifierMovement::CompareModifierTables(uint32 RemoteChecksum, uint32 RemoteVersion, const TCHAR* Remote) const
+{
+	if (RemoteChecksum != GetModifierLevelsChecksum())
+	{
+		// Modifier levels are sent as indexes, so every modifier would be misinterpreted
+		UE_LOG(LogModifierMovement, Error, TEXT("%s: Modifier levels differ from the %s, Boost, Snare and SlowFall must match"),
+			*GetNameSafe(CharacterOwner), Remote);
+	}
+	else if (RemoteVersion != GetModifierTablesVersion())
+	{
+		// Levels agree but params don't, every modifier will cause corrections
+		UE_LOG(LogModifierMovement, Warning, TEXT("%s: Modifier params differ from the %s, version %08X vs %08X, reload them on both"),
+			*GetNameSafe(CharacterOwner), Remote, GetModifierTablesVersion(), RemoteVersion);
+	}
+}
+
 void UModifierMovement::UpdateModifierMovementState()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::UpdateModifierMovementState);
@@ -323,10 +848,11 @@ void UModifierMovement::UpdateModifierMovementState()
 		return;
 	}
 
-	// Initialize Modifier levels if empty
-	if (BoostLevels.Num() == 0)	{ for (const auto& Level : Boost) { BoostLevels.Add(Level.Key); } }
-	if (SnareLevels.Num() == 0)	{ for (const auto& Level : Snare) { SnareLevels.Add(Level.Key); } }
-	if (SlowFallLevels.Num() == 0) { for (const auto& Level : SlowFall) { SlowFallLevels.Add(Level.Key); } }
+	// Remove timed modifiers -- Proxies get replicated Modifier state
+	if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
+	{
+		ExpireModifiers();
+	}
 
 	// Update the modifiers
 	ProcessModifierMovementState();
@@ -340,7 +866,23 @@ void UModifierMovement::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 	}
 	
 	const bool bWasSlowFalling = IsSlowFallActive();
-	UpdateModifierMovementState();
+
+	if (IsAIFastPath())
+	{
+		// Server controlled AI has nothing to predict, compute the levels once per tick
+		UpdateAIModifierMovementState(DeltaSeconds);
+	}
+	else
+	{
+		// Zones and surfaces are sampled once per move, from the position and floor the move starts at, which the server shares
+		if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
+		{
+			UpdateZoneModifiers();
+			UpdateSurfaceModifiers();
+		}
+	
+		UpdateModifierMovementState();
+	}
 
 	if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
 	{
@@ -350,13 +892,33 @@ void UModifierMovement::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 			Velocity.Z = 0.f;
 		}
 	}
+
+	// Record the state the modifiers were evaluated in
+	PreMoveMovementMode = MovementMode;
+	PreMoveCustomMovementMode = CustomMovementMode;
+	bPreMoveSimulatingPhysics = UpdatedComponent->IsSimulatingPhysics();
 	
 	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
 }
 
+bool UModifierMovement::ShouldUpdateModifiersAfterMovement() const
+{
+	if (!bSinglePassModifierUpdate)
+	{
+		return true;
+	}
+
+	// Only the state that determines if modifiers can be active needs re-evaluating
+	return MovementMode != PreMoveMovementMode || CustomMovementMode != PreMoveCustomMovementMode ||
+		UpdatedComponent->IsSimulatingPhysics() != bPreMoveSimulatingPhysics;
+}
+
 void UModifierMovement::UpdateCharacterStateAfterMovement(float DeltaSeconds)
 {
-	UpdateModifierMovementState();
+	if (HasValidData() && !IsAIFastPath() && ShouldUpdateModifiersAfterMovement())
+	{
+		UpdateModifierMovementState();
+	}
 
 	Super::UpdateCharacterStateAfterMovement(DeltaSeconds);
 }
@@ -365,7 +927,7 @@ FClientAuthData* UModifierMovement::ProcessClientAuthData()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::ProcessClientAuthData);
 	
-	ClientAuthStack.SortByPriority();
+	// The stack is always ordered by priority
 	return ClientAuthStack.GetFirst();
 }
 
@@ -377,35 +939,9 @@ FClientAuthParams UModifierMovement::GetClientAuthParams(const FClientAuthData*
 	{
 		return {};
 	}
-	
-	FClientAuthParams Params = { false, 0.f, 0.f, 0.f, ClientAuthData->Priority };
-
-	// Get all active client auth data that matches the priority
-	TArray<FClientAuthData> Priority = ClientAuthStack.FilterPriority(ClientAuthData->Priority);
-
-	// Combine the parameters
-	int32 Num = 0;
-	for (const FClientAuthData& Data : Priority)
-	{
-		if (const FClientAuthParams* DataParams = GetClientAuthParamsForSource(Data.Source))
-		{
-			Params.ClientAuthTime += DataParams->ClientAuthTime;
-			Params.MaxClientAuthDistance += DataParams->MaxClientAuthDistance;
-			Params.RejectClientAuthDistance += DataParams->RejectClientAuthDistance;
-			Num++;
-		}
-	}
 
-	// Average the parameters
-	Params.bEnableClientAuth = Num > 0;
-	if (Num > 1)
-	{
-		Params.ClientAuthTime /= Num;
-		Params.MaxClientAuthDistance /= Num;
-		Params.RejectClientAuthDistance /= Num;
-	}
-
-	return Params;
+	// Combined params of all active client auth data that matches the priority, cached for the top priority
+	return ClientAuthStack.GetParams(ClientAuthData->Priority);
 }
 
 void UModifierMovement::GrantClientAuthority(FGameplayTag ClientAuthSource, float OverrideDuration)
@@ -422,14 +958,7 @@ void UModifierMovement::GrantClientAuthority(FGameplayTag ClientAuthSource, floa
 		if (Params->bEnableClientAuth)
 		{
 			const float Duration = OverrideDuration > 0.f ? OverrideDuration : Params->ClientAuthTime;
-			ClientAuthStack.Stack.Add(FClientAuthData(ClientAuthSource, Duration, Params->Priority, ++ClientAuthIdCounter));
-
-			// Limit the number of auth data entries
-			// IMPORTANT: We do not allow serializing more than 8, if this changes, update the serialization code too
-			if (ClientAuthStack.Stack.Num() > 8)
-			{
-				ClientAuthStack.Stack.RemoveAt(0);
-			}
+			ClientAuthStack.Push(ClientAuthSource, *Params, Duration, ++ClientAuthIdCounter);
 		}
 	}
 	else
@@ -470,8 +999,10 @@ bool UModifierMovement::ServerShouldGrantClientPositionAuthority(FVector& Client
 		return false;
 	}
 
-	// Get auth params
-	const FClientAuthParams Params = GetClientAuthParams(AuthData);
+	// Get auth params, scaled to suit this connection
+	FClientAuthParams Params = GetClientAuthParams(AuthData);
+	Params.MaxClientAuthDistance *= GetClientAuthDistanceScale();
+	Params.RejectClientAuthDistance *= GetClientAuthDistanceScale();
 
 	// Disabled
 	if (!Params.bEnableClientAuth)
@@ -481,7 +1012,7 @@ bool UModifierMovement::ServerShouldGrantClientPositionAuthority(FVector& Client
 
 	// Validate auth data
 #if !UE_BUILD_SHIPPING
-	if (UNLIKELY(AuthData->TimeRemaining <= 0.f))
+	if (UNLIKELY(ClientAuthStack.GetTimeRemaining(*AuthData) <= 0.f))
 	{
 		// ServerMoveHandleClientError() should have removed the auth data already
 		return ensure(false);
@@ -537,10 +1068,10 @@ void UModifierMovement::ServerMove_PerformMovement(const FCharacterNetworkMoveDa
 	
 	const FModifierNetworkMoveData& ModifierMoveData = static_cast<const FModifierNetworkMoveData&>(MoveData);
 
-	BoostLocal.ServerMove_PerformMovement(ModifierMoveData.BoostLocal.WantsModifiers);
-	BoostCorrection.ServerMove_PerformMovement(ModifierMoveData.BoostCorrection.WantsModifiers);
+	BoostLocal.ServerMove_PerformMovement(ModifierMoveData.BoostLocal.WantsModifiers, ModifierMoveData.BoostLocal.WantsExpiry);
+	BoostCorrection.ServerMove_PerformMovement(ModifierMoveData.BoostCorrection.WantsModifiers, ModifierMoveData.BoostCorrection.WantsExpiry);
 
-	SlowFallLocal.ServerMove_PerformMovement(ModifierMoveData.SlowFallLocal.WantsModifiers);
+	SlowFallLocal.ServerMove_PerformMovement(ModifierMoveData.SlowFallLocal.WantsModifiers, ModifierMoveData.SlowFallLocal.WantsExpiry);
 
 	Super::ServerMove_PerformMovement(MoveData);
 }
@@ -577,13 +1108,17 @@ void UModifierMovement::ServerMoveHandleClientError(float ClientTimeStamp, float
 	// Client >> TickComponent ➜ ControlledCharacterMove ➜ CallServerMovePacked ➜ ReplicateMoveToServer >> Server
 	// >> ServerMove_PerformMovement ➜ ServerMoveHandleClientError
 
+	// Measure the error before client authority resolves it, to adapt the client auth distances to this connection
+	const float PositionError = AdaptiveClientAuthCorrection.bEnabled ?
+		FVector::Dist(FRepMovement::RebaseOntoZeroOrigin(RelativeClientLocation, this), UpdatedComponent->GetComponentLocation()) : 0.f;
+
 	// Process and grant client authority
 #if !UE_BUILD_SHIPPING
 	if (!ModifierMovementCVars::bClientAuthDisabled)
 #endif
 	{
-		// Update client authority time remaining
-		ClientAuthStack.Update(DeltaTime);
+		// Advance client authority time, removing expired auth data
+		ClientAuthStack.Advance(DeltaTime);
 
 		// Test for client authority
 		FVector ClientLoc = FRepMovement::RebaseOntoZeroOrigin(RelativeClientLocation, this);
@@ -602,6 +1137,20 @@ void UModifierMovement::ServerMoveHandleClientError(float ClientTimeStamp, float
 
 	Super::ServerMoveHandleClientError(ClientTimeStamp, DeltaTime, Accel, RelativeClientLocation, ClientMovementBase,
 		ClientBaseBoneName, ClientMovementMode);
+
+	if (AdaptiveClientAuthCorrection.bEnabled)
+	{
+		// Normalize against the engine's allowable position error, which is what triggers a correction
+		const float AllowableError = FMath::Sqrt(GetDefault<AGameNetworkManager>()->MAXPOSITIONERRORSQUARED);
+		const FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+		const bool bCorrected = ServerData && ServerData->PendingAdjustment.TimeStamp == ClientTimeStamp &&
+			!ServerData->PendingAdjustment.bAckGoodMove;
+		if (AllowableError > 0.f)
+		{
+			AdaptiveClientAuthState.AddSample(AdaptiveClientAuthCorrection, PositionError / AllowableError, bCorrected, DeltaTime);
+			SET_FLOAT_STAT(STAT_ClientAuthDistanceScale, GetClientAuthDistanceScale());
+		}
+	}
 }
 
 void UModifierMovement::ClientAdjustPosition_Implementation(float TimeStamp, FVector NewLoc, FVector NewVel,
@@ -642,9 +1191,17 @@ void UModifierMovement::OnClientCorrectionReceived(class FNetworkPredictionData_
 	
 	const FModifierMoveResponseDataContainer& MoveResponse = static_cast<const FModifierMoveResponseDataContainer&>(GetMoveResponseDataContainer());
 
-	BoostCorrection.OnClientCorrectionReceived(MoveResponse.BoostCorrection.Modifiers);
-	BoostServer.OnClientCorrectionReceived(MoveResponse.BoostServer.Modifiers);
-	SnareServer.OnClientCorrectionReceived(MoveResponse.SnareServer.Modifiers);
+	BoostCorrection.OnClientCorrectionReceived(MoveResponse.BoostCorrection.Modifiers, MoveResponse.BoostCorrection.Expiry);
+	BoostServer.OnClientCorrectionReceived(MoveResponse.BoostServer.Modifiers, MoveResponse.BoostServer.Expiry);
+	SnareServer.OnClientCorrectionReceived(MoveResponse.SnareServer.Modifiers, MoveResponse.SnareServer.Expiry);
+
+	// The correction was for a move from before our timestamp reset, so the expiry is too
+	if (TimeStamp > GetModifierTimestamp() + MinTimeBetweenTimeStampResets * 0.5f)
+	{
+		BoostCorrection.RebaseExpiry(-MinTimeBetweenTimeStampResets);
+		BoostServer.RebaseExpiry(-MinTimeBetweenTimeStampResets);
+		SnareServer.RebaseExpiry(-MinTimeBetweenTimeStampResets);
+	}
 
 	Super::OnClientCorrectionReceived(ClientData, TimeStamp, UpdatedComponent->GetComponentLocation(), NewVelocity, NewBase, NewBaseBoneName,
 		bHasBase, bBaseRelativePosition, ServerMovementMode, ServerGravityDirection);
@@ -652,17 +1209,18 @@ void UModifierMovement::OnClientCorrectionReceived(class FNetworkPredictionData_
 
 bool UModifierMovement::ClientUpdatePositionAfterServerUpdate()
 {
-	const TModifierStack RealBoostLocal = BoostLocal.WantsModifiers;
-	const TModifierStack RealBoostCorrection = BoostCorrection.WantsModifiers;
-	const TModifierStack RealSlowFallLocal = SlowFallLocal.WantsModifiers;
+	// Copied whole so that handles survive the replay
+	const TMod_Local RealBoostLocal = BoostLocal;
+	const TMod_LocalCorrection RealBoostCorrection = BoostCorrection;
+	const TMod_Local RealSlowFallLocal = SlowFallLocal;
 
 	const FVector ClientLoc = UpdatedComponent->GetComponentLocation();
 	
 	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
 	
-	BoostLocal.WantsModifiers = RealBoostLocal;
-	BoostCorrection.WantsModifiers = RealBoostCorrection;
-	SlowFallLocal.WantsModifiers = RealSlowFallLocal;
+	BoostLocal.RestoreWantsModifiers(RealBoostLocal);
+	BoostCorrection.RestoreWantsModifiers(RealBoostCorrection);
+	SlowFallLocal.RestoreWantsModifiers(RealSlowFallLocal);
 
 	// Preserve client location relative to the partial client authority we have
 	const FVector AuthLocation = FMath::Lerp<FVector>(UpdatedComponent->GetComponentLocation(), ClientLoc, ClientAuthAlpha);
@@ -671,6 +1229,24 @@ bool UModifierMovement::ClientUpdatePositionAfterServerUpdate()
 	return bResult;
 }
 
+void UModifierMovement::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+	const FVector& NewAccel)
+{
+	// Autonomous proxies only call MoveAutonomous() when replaying saved moves
+	const bool bReplaying = CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy;
+	if (bReplaying)
+	{
+		ReplayingMoveTimestamp = ClientTimeStamp;
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+
+	if (bReplaying)
+	{
+		ReplayingMoveTimestamp = -1.f;
+	}
+}
+
 void UModifierMovement::TickCharacterPose(float DeltaTime)
 {
 	/*
@@ -753,9 +1329,9 @@ void FSavedMove_Character_Modifier::SetMoveFor(ACharacter* C, float InDeltaTime,
 
 	if (const UModifierMovement* MoveComp = Cast<AModifierCharacter>(C)->GetModifierCharacterMovement())
 	{
-		BoostLocal.SetMoveFor(MoveComp->BoostLocal.WantsModifiers);
-		BoostCorrection.SetMoveFor(MoveComp->BoostCorrection.WantsModifiers);
-		SlowFallLocal.SetMoveFor(MoveComp->SlowFallLocal.WantsModifiers);
+		BoostLocal.SetMoveFor(MoveComp->BoostLocal.WantsModifiers, MoveComp->BoostLocal.WantsExpiry);
+		BoostCorrection.SetMoveFor(MoveComp->BoostCorrection.WantsModifiers, MoveComp->BoostCorrection.WantsExpiry);
+		SlowFallLocal.SetMoveFor(MoveComp->SlowFallLocal.WantsModifiers, MoveComp->SlowFallLocal.WantsExpiry);
 	}
 }
 
@@ -781,10 +1357,10 @@ bool FSavedMove_Character_Modifier::CanCombineWith(const FSavedMovePtr& NewMove,
 	// We can only combine moves if they will result in the same state as if both moves were processed individually,
 	// because the AutonomousProxy Client processes them individually prior to sending them to the server.
 
-	if (!BoostLocal.CanCombineWith(SavedMove->BoostLocal.WantsModifiers)) { return false; }
-	if (!BoostCorrection.CanCombineWith(SavedMove->BoostCorrection.WantsModifiers)) { return false; }
+	if (!BoostLocal.CanCombineWith(SavedMove->BoostLocal.WantsModifiers, SavedMove->BoostLocal.WantsExpiry)) { return false; }
+	if (!BoostCorrection.CanCombineWith(SavedMove->BoostCorrection.WantsModifiers, SavedMove->BoostCorrection.WantsExpiry)) { return false; }
 
-	if (!SlowFallLocal.CanCombineWith(SavedMove->SlowFallLocal.WantsModifiers)) { return false; }
+	if (!SlowFallLocal.CanCombineWith(SavedMove->SlowFallLocal.WantsModifiers, SavedMove->SlowFallLocal.WantsExpiry)) { return false; }
 
 	// Without these, the change/start/stop events will trigger twice causing de-sync, so we don't combine moves if the level changes
 	if (BoostLevel != SavedMove->BoostLevel) { return false; }
@@ -804,9 +1380,9 @@ void FSavedMove_Character_Modifier::SetInitialPosition(ACharacter* C)
 	// Retrieve the value from our CMC to revert the saved move value back to this.
 	if (const UModifierMovement* MoveComp = Cast<AModifierCharacter>(C)->GetModifierCharacterMovement())
 	{
-		BoostLocal.SetInitialPosition(MoveComp->BoostLocal.WantsModifiers);
-		BoostCorrection.SetInitialPosition(MoveComp->BoostCorrection.WantsModifiers);
-		SlowFallLocal.SetInitialPosition(MoveComp->SlowFallLocal.WantsModifiers);
+		BoostLocal.SetInitialPosition(MoveComp->BoostLocal.WantsModifiers, MoveComp->BoostLocal.WantsExpiry);
+		BoostCorrection.SetInitialPosition(MoveComp->BoostCorrection.WantsModifiers, MoveComp->BoostCorrection.WantsExpiry);
+		SlowFallLocal.SetInitialPosition(MoveComp->SlowFallLocal.WantsModifiers, MoveComp->SlowFallLocal.WantsExpiry);
 
 		BoostLevel = MoveComp->BoostLevel;
 		SnareLevel = MoveComp->SnareLevel;
@@ -823,9 +1399,9 @@ void FSavedMove_Character_Modifier::CombineWith(const FSavedMove_Character* OldM
 
 	if (UModifierMovement* MoveComp = C ? Cast<UModifierMovement>(C->GetCharacterMovement()) : nullptr)
 	{
-		MoveComp->BoostLocal.CombineWith(SavedOldMove->BoostLocal.WantsModifiers);
-		MoveComp->BoostCorrection.CombineWith(SavedOldMove->BoostCorrection.WantsModifiers);
-		MoveComp->SlowFallLocal.CombineWith(SavedOldMove->SlowFallLocal.WantsModifiers);
+		MoveComp->BoostLocal.CombineWith(SavedOldMove->BoostLocal.WantsModifiers, SavedOldMove->BoostLocal.WantsExpiry);
+		MoveComp->BoostCorrection.CombineWith(SavedOldMove->BoostCorrection.WantsModifiers, SavedOldMove->BoostCorrection.WantsExpiry);
+		MoveComp->SlowFallLocal.CombineWith(SavedOldMove->SlowFallLocal.WantsModifiers, SavedOldMove->SlowFallLocal.WantsExpiry);
 
 		MoveComp->BoostLevel = SavedOldMove->BoostLevel;
 		MoveComp->SnareLevel = SavedOldMove->SnareLevel;
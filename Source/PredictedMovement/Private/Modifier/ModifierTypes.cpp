@@ -0,0 +1,172 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierTypes.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierTypes)
+
+void FFallingModifierParams::BakeGravityScalarTable()
+{
+	bGravityScalarTableBaked = false;
+
+	if (!bGravityScalarFromVelocityZ)
+	{
+		return;
+	}
+
+	if (!ensureMsgf(GravityScalarFallVelocityCurve != nullptr, TEXT("GravityScalarFallVelocityCurve must be set")))
+	{
+		return;
+	}
+
+	float MinZ, MaxZ;
+	GravityScalarFallVelocityCurve->GetTimeRange(MinZ, MaxZ);
+
+	const float Step = (MaxZ - MinZ) / (GravityScalarTableSize - 1);
+	GravityScalarTableMinZ = MinZ;
+	GravityScalarTableInvStep = Step > UE_KINDA_SMALL_NUMBER ? 1.f / Step : 0.f;
+
+	for (int32 Index = 0; Index < GravityScalarTableSize; Index++)
+	{
+		GravityScalarTable[Index] = GravityScalarFallVelocityCurve->GetFloatValue(MinZ + Step * Index);
+	}
+
+	bGravityScalarTableBaked = true;
+}
+
+void FClientAuthStack::Push(const FGameplayTag& Source, const FClientAuthParams& Params, float Duration, uint64 Id)
+{
+	// Limit the number of auth data entries by removing the oldest
+	if (Stack.Num() >= MaxEntries)
+	{
+		int32 OldestIndex = 0;
+		for (int32 Index = 1; Index < Stack.Num(); Index++)
+		{
+			if (Stack[Index].Id < Stack[OldestIndex].Id)
+			{
+				OldestIndex = Index;
+			}
+		}
+		Stack.RemoveAt(OldestIndex);
+	}
+
+	// Insert after every entry of equal or higher importance, so the stack remains ordered without sorting
+	int32 InsertIndex = Stack.Num();
+	while (InsertIndex > 0 && Stack[InsertIndex - 1].Priority > Params.Priority)
+	{
+		InsertIndex--;
+	}
+	Stack.Insert(FClientAuthData(Source, Time + Duration, Params, Id), InsertIndex);
+
+	OnStackChanged();
+}
+
+FClientAuthParams FClientAuthStack::GetParams(int32 Priority) const
+{
+	return Stack.Num() > 0 && Priority == Stack[0].Priority ? TopParams : CombineParams(Priority);
+}
+
+FClientAuthParams FClientAuthStack::CombineParams(int32 Priority) const
+{
+	FClientAuthParams Params = { false, 0.f, 0.f, 0.f, Priority };
+
+	// Combine the parameters
+	int32 Num = 0;
+	for (const FClientAuthData& Data : Stack)
+	{
+		if (Data.Priority == Priority)
+		{
+			Params.ClientAuthTime += Data.Params.ClientAuthTime;
+			Params.MaxClientAuthDistance += Data.Params.MaxClientAuthDistance;
+			Params.RejectClientAuthDistance += Data.Params.RejectClientAuthDistance;
+			Num++;
+		}
+	}
+
+	// Average the parameters
+	Params.bEnableClientAuth = Num > 0;
+	if (Num > 1)
+	{
+		Params.ClientAuthTime /= Num;
+		Params.MaxClientAuthDistance /= Num;
+		Params.RejectClientAuthDistance /= Num;
+	}
+
+	return Params;
+}
+
+void FClientAuthStack::RemoveExpired()
+{
+	const double CurrentTime = Time;
+	Stack.RemoveAll([CurrentTime](const FClientAuthData& Data)
+	{
+		return Data.ExpiryTime <= CurrentTime;
+	});
+
+	OnStackChanged();
+}
+
+void FClientAuthStack::OnStackChanged()
+{
+	NextExpiry = MAX_dbl;
+	for (const FClientAuthData& Data : Stack)
+	{
+		NextExpiry = FMath::Min(NextExpiry, Data.ExpiryTime);
+	}
+
+	TopParams = Stack.Num() > 0 ? CombineParams(Stack[0].Priority) : FClientAuthParams(false, 0.f, 0.f, 0.f, INT32_MAX);
+}
+
+bool FSimulatedModifierLevels::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	static constexpr uint32 NumModifiers = (uint32)ESimulatedModifier::MAX;
+	static_assert(NumModifiers <= 8, "Active mask is serialized as a single byte");
+
+	// Which levels are active, inactive levels aren't sent
+	uint8 ActiveMask = 0;
+	uint32 MaxLevel = 0;
+	if (Ar.IsSaving())
+	{
+		for (uint32 i = 0; i < NumModifiers; ++i)
+		{
+			if (Levels[i] != NO_MODIFIER)
+			{
+				ActiveMask |= 1 << i;
+				MaxLevel = FMath::Max<uint32>(MaxLevel, Levels[i]);
+			}
+		}
+	}
+	Ar.SerializeBits(&ActiveMask, NumModifiers);
+
+	if (ActiveMask != 0)
+	{
+		// Bits per level, enough for the highest active level, 1 to 8 sent as 0 to 7
+		uint32 LevelBits = Ar.IsSaving() ? FMath::Max<uint32>(1, FMath::CeilLogTwo(MaxLevel + 1)) - 1 : 0;
+		Ar.SerializeInt(LevelBits, 8);
+		LevelBits += 1;
+
+		for (uint32 i = 0; i < NumModifiers; ++i)
+		{
+			if (ActiveMask & (1 << i))
+			{
+				uint8 Level = Ar.IsSaving() ? Levels[i] : 0;
+				Ar.SerializeBits(&Level, LevelBits);
+				Levels[i] = Level;
+			}
+			else
+			{
+				Levels[i] = NO_MODIFIER;
+			}
+		}
+	}
+	else if (Ar.IsLoading())
+	{
+		for (uint8& Level : Levels)
+		{
+			Level = NO_MODIFIER;
+		}
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
@@ -0,0 +1,104 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierZoneComponent.h"
+
+#include "Modifier/ModifierTags.h"
+#include "Modifier/ModifierZoneSubsystem.h"
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierZoneComponent)
+
+UModifierZoneComponent::UModifierZoneComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Evaluated from position by the movement component, not by overlaps
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetGenerateOverlapEvents(false);
+	SetCanEverAffectNavigation(false);
+	bHiddenInGame = true;
+}
+
+void UModifierZoneComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	RegisterZone();
+}
+
+void UModifierZoneComponent::OnUnregister()
+{
+	UnregisterZone();
+
+	Super::OnUnregister();
+}
+
+void UModifierZoneComponent::SetLevel(FGameplayTag InLevel)
+{
+	if (Level != InLevel)
+	{
+		Level = InLevel;
+		RegisterZone();
+	}
+}
+
+void UModifierZoneComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	if (ZoneId != INDEX_NONE)
+	{
+		RegisterZone();
+	}
+}
+
+void UModifierZoneComponent::RegisterZone()
+{
+	UModifierZoneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UModifierZoneSubsystem>() : nullptr;
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	FModifierZone Zone;
+	if (Level.MatchesTag(FModifierTags::Modifier_Boost))
+	{
+		Zone.ModifierType = FModifierTags::Modifier_Boost;
+	}
+	else if (Level.MatchesTag(FModifierTags::Modifier_Snare))
+	{
+		Zone.ModifierType = FModifierTags::Modifier_Snare;
+	}
+	else if (Level.MatchesTag(FModifierTags::Modifier_SlowFall))
+	{
+		Zone.ModifierType = FModifierTags::Modifier_SlowFall;
+	}
+	else
+	{
+		// Not a modifier we know how to apply
+		UnregisterZone();
+		return;
+	}
+
+	// Scale is applied to the extent instead, so the inverse transform is only rotation and translation
+	const FTransform& Transform = GetComponentTransform();
+	Zone.InverseTransform = FTransform(Transform.GetRotation(), Transform.GetLocation()).Inverse();
+	Zone.Extent = GetScaledBoxExtent();
+	Zone.Bounds = Bounds.GetBox();
+	Zone.Level = Level;
+	Zone.Component = this;
+
+	ZoneId = Subsystem->RegisterZone(ZoneId, Zone);
+}
+
+void UModifierZoneComponent::UnregisterZone()
+{
+	if (ZoneId != INDEX_NONE)
+	{
+		if (UModifierZoneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UModifierZoneSubsystem>() : nullptr)
+		{
+			Subsystem->UnregisterZone(ZoneId);
+		}
+		ZoneId = INDEX_NONE;
+	}
+}
@@ -0,0 +1,126 @@
+﻿// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierZoneSubsystem.h"
+
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierZoneSubsystem)
+
+bool UModifierZoneSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UModifierZoneSubsystem::RegisterZone(int32 ZoneId, const FModifierZone& Zone)
+{
+	if (Zones.IsValidIndex(ZoneId))
+	{
+		RemoveFromCells(ZoneId);
+		Zones[ZoneId] = Zone;
+	}
+	else
+	{
+		ZoneId = Zones.Add(Zone);
+	}
+
+	AddToCells(ZoneId);
+	return ZoneId;
+}
+
+void UModifierZoneSubsystem::UnregisterZone(int32 ZoneId)
+{
+	if (Zones.IsValidIndex(ZoneId))
+	{
+		RemoveFromCells(ZoneId);
+		Zones.RemoveAt(ZoneId);
+	}
+}
+
+void UModifierZoneSubsystem::GetZonesAtLocation(const FVector& Location, TModifierZoneQuery& OutZones) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierZoneSubsystem::GetZonesAtLocation);
+
+	OutZones.Reset();
+
+	const TArray<int32, TInlineAllocator<2>>* Cell = Cells.Find(GetCell(Location));
+	if (!Cell)
+	{
+		return;
+	}
+
+	for (const int32 ZoneId : *Cell)
+	{
+		const FModifierZone& Zone = Zones[ZoneId];
+		if (Zone.Contains(Location))
+		{
+			OutZones.Add(&Zone);
+		}
+	}
+}
+
+void UModifierZoneSubsystem::SetCellSize(float InCellSize)
+{
+	InCellSize = FMath::Max(InCellSize, 100.f);
+	if (InCellSize == CellSize)
+	{
+		return;
+	}
+
+	CellSize = InCellSize;
+	Cells.Reset();
+	for (auto It = Zones.CreateConstIterator(); It; ++It)
+	{
+		AddToCells(It.GetIndex());
+	}
+}
+
+FIntVector UModifierZoneSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UModifierZoneSubsystem::AddToCells(int32 ZoneId)
+{
+	const FBox& Bounds = Zones[ZoneId].Bounds;
+	const FIntVector Min = GetCell(Bounds.Min);
+	const FIntVector Max = GetCell(Bounds.Max);
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(ZoneId);
+			}
+		}
+	}
+}
+
+void UModifierZoneSubsystem::RemoveFromCells(int32 ZoneId)
+{
+	const FBox& Bounds = Zones[ZoneId].Bounds;
+	const FIntVector Min = GetCell(Bounds.Min);
+	const FIntVector Max = GetCell(Bounds.Max);
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				const FIntVector Key(X, Y, Z);
+				if (TArray<int32, TInlineAllocator<2>>* Cell = Cells.Find(Key))
+				{
+					Cell->Remove(ZoneId);
+					if (Cell->Num() == 0)
+					{
+						Cells.Remove(Key);
+					}
+				}
+			}
+		}
+	}
+}
@@ -2,11 +2,20 @@
 
 #include "PredictedMovement.h"
 
+#include "Misc/CoreDelegates.h"
+#include "System/PredictedInputFlags.h"
+
 #define LOCTEXT_NAMESPACE "FPredictedMovementModule"
 
 void FPredictedMovementModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// Game modules may allocate input flags after we load, assign them once everything has loaded
+	FCoreDelegates::OnPostEngineInit.AddLambda([]()
+	{
+		FPredictedInputFlagRegistry::Get().Finalize();
+	});
 }
 
 void FPredictedMovementModule::ShutdownModule()
@@ -16,6 +16,11 @@ AProneCharacter::AProneCharacter(const FObjectInitializer& FObjectInitializer)
 	ProneMovement = Cast<UProneMovement>(GetCharacterMovement());
 
 	PronedEyeHeight = 30.f;
+
+	DefaultMeshRelativeZ = 0.f;
+	DefaultBaseTranslationOffsetZ = 0.f;
+	bDefaultHasMesh = false;
+	bStanceDefaultsCached = false;
 }
 
 void AProneCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -33,6 +38,22 @@ void AProneCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutL
 	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, bIsProned, SharedParams);
 }
 
+void AProneCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	CacheStanceDefaults();
+}
+
+void AProneCharacter::CacheStanceDefaults()
+{
+	const ACharacter* DefaultChar = GetDefault<ACharacter>(GetClass());
+	bDefaultHasMesh = DefaultChar->GetMesh() != nullptr;
+	DefaultMeshRelativeZ = bDefaultHasMesh ? DefaultChar->GetMesh()->GetRelativeLocation().Z : 0.f;
+	DefaultBaseTranslationOffsetZ = DefaultChar->GetBaseTranslationOffset().Z;
+	bStanceDefaultsCached = true;
+}
+
 void AProneCharacter::RecalculateBaseEyeHeight()
 {
 	if (bIsProned)
@@ -101,16 +122,20 @@ void AProneCharacter::OnStartProne(float HeightAdjust, float ScaledHeightAdjust)
 {
 	RecalculateBaseEyeHeight();
 
-	const ACharacter* DefaultChar = GetDefault<ACharacter>(GetClass());
-	if (GetMesh() && DefaultChar->GetMesh())
+	if (!bStanceDefaultsCached)
+	{
+		CacheStanceDefaults();
+	}
+
+	if (GetMesh() && bDefaultHasMesh)
 	{
 		FVector& MeshRelativeLocation = GetMesh()->GetRelativeLocation_DirectMutable();
-		MeshRelativeLocation.Z = DefaultChar->GetMesh()->GetRelativeLocation().Z + HeightAdjust;
+		MeshRelativeLocation.Z = DefaultMeshRelativeZ + HeightAdjust;
 		BaseTranslationOffset.Z = MeshRelativeLocation.Z;
 	}
 	else
 	{
-		BaseTranslationOffset.Z = DefaultChar->GetBaseTranslationOffset().Z + HeightAdjust;
+		BaseTranslationOffset.Z = DefaultBaseTranslationOffsetZ + HeightAdjust;
 	}
 
 	K2_OnStartProne(HeightAdjust, ScaledHeightAdjust);
@@ -122,16 +147,20 @@ void AProneCharacter::OnEndProne(float HeightAdjust, float ScaledHeightAdjust)
 
 	if (!bIsCrouched)
 	{
-		const ACharacter* DefaultChar = GetDefault<ACharacter>(GetClass());
-		if (GetMesh() && DefaultChar->GetMesh())
+		if (!bStanceDefaultsCached)
+		{
+			CacheStanceDefaults();
+		}
+
+		if (GetMesh() && bDefaultHasMesh)
 		{
 			FVector& MeshRelativeLocation = GetMesh()->GetRelativeLocation_DirectMutable();
-			MeshRelativeLocation.Z = DefaultChar->GetMesh()->GetRelativeLocation().Z;
+			MeshRelativeLocation.Z = DefaultMeshRelativeZ;
 			BaseTranslationOffset.Z = MeshRelativeLocation.Z;
 		}
 		else
 		{
-			BaseTranslationOffset.Z = DefaultChar->GetBaseTranslationOffset().Z;
+			BaseTranslationOffset.Z = DefaultBaseTranslationOffsetZ;
 		}
 	}
 	K2_OnEndProne(HeightAdjust, ScaledHeightAdjust);
@@ -6,9 +6,15 @@
 #include "Components/CapsuleComponent.h"
 #include "Prone/ProneCharacter.h"
 #include "Engine/World.h"
+#include "System/PredictedMovementStats.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(ProneMovement)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Prone Encroachment Tests Skipped"), STAT_ProneEncroachmentTestsSkipped, STATGROUP_PredictedMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stance Move Sweeps Skipped"), STAT_StanceMoveSweepsSkipped, STATGROUP_PredictedMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stance Penetration Sweeps Skipped"), STAT_StancePenetrationSweepsSkipped, STATGROUP_PredictedMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stance Floor Checks Skipped"), STAT_StanceFloorChecksSkipped, STATGROUP_PredictedMovement);
+
 UProneMovement::UProneMovement(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -23,9 +29,14 @@ UProneMovement::UProneMovement(const FObjectInitializer& ObjectInitializer)
 
 	ProneLockDuration = 1.f;
 
+	EncroachmentRetryDistance = 5.f;
+	EncroachmentRetryInterval = 0.25f;
+
 	bCanWalkOffLedgesWhenProned = false;
 	bWantsToProne = false;
 	bProneLocked = false;
+
+	CapsuleStance = EPredictedStance::Stand;
 }
 
 bool UProneMovement::HasValidData() const
@@ -45,6 +56,8 @@ void UProneMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
 	Super::SetUpdatedComponent(NewUpdatedComponent);
 
 	ProneCharacterOwner = Cast<AProneCharacter>(PawnOwner);
+
+	RefreshStanceTable();
 }
 
 float UProneMovement::GetMaxAcceleration() const
@@ -144,6 +157,12 @@ void UProneMovement::SetProneLock(bool bLock)
 
 float UProneMovement::GetTimestamp() const
 {
+	if (ReplayingMoveTimestamp >= 0.f)
+	{
+		// Client replaying a saved move
+		return ReplayingMoveTimestamp;
+	}
+
 	if (CharacterOwner->GetLocalRole() == ROLE_Authority)
 	{
 		if (CharacterOwner->IsLocallyControlled())
@@ -166,116 +185,244 @@ float UProneMovement::GetTimestamp() const
 	}
 }
 
-bool UProneMovement::IsProned() const
+bool UProneMovement::IsEncroachmentCached(const FProneEncroachmentCache& Cache) const
 {
-	return ProneCharacterOwner && ProneCharacterOwner->IsProned();
+	if (EncroachmentRetryInterval <= 0.f || !Cache.bBlocked)
+	{
+		return false;
+	}
+
+	if (Cache.IsBlocked(UpdatedComponent->GetComponentLocation(), GetMovementBase(), CurrentFloor.HitResult.GetComponent(),
+		GetTimestamp(), EncroachmentRetryDistance, EncroachmentRetryInterval))
+	{
+		INC_DWORD_STAT(STAT_ProneEncroachmentTestsSkipped);
+		return true;
+	}
+	return false;
 }
 
-void UProneMovement::Prone(bool bClientSimulation)
+void UProneMovement::CacheEncroachment(FProneEncroachmentCache& Cache) const
 {
-	if (!HasValidData())
+	if (EncroachmentRetryInterval > 0.f)
 	{
-		return;
+		Cache.SetBlocked(UpdatedComponent->GetComponentLocation(), GetMovementBase(),
+			CurrentFloor.HitResult.GetComponent(), GetTimestamp());
 	}
+}
 
-	if (!bClientSimulation && !CanProneInCurrentState())
+void UProneMovement::InvalidateEncroachmentCache()
+{
+	for (FProneEncroachmentCache& Cache : EncroachmentCache)
+	{
+		Cache.Invalidate();
+	}
+}
+
+void UProneMovement::RefreshStanceTable()
+{
+	if (!CharacterOwner || !CharacterOwner->GetCapsuleComponent())
 	{
 		return;
 	}
 
-	// See if collision is already at desired size.
-	if (CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight() == PronedHalfHeight &&
-		CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleRadius() == PronedRadius)
+	// Cache the default capsule, so transitions don't need to read the class default object
+	const ACharacter* DefaultCharacter = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>();
+	const UCapsuleComponent* DefaultCapsule = DefaultCharacter->GetCapsuleComponent();
+
+	DefaultStanceParams.Radius = DefaultCapsule->GetUnscaledCapsuleRadius();
+	DefaultStanceParams.HalfHeight = DefaultCapsule->GetUnscaledCapsuleHalfHeight();
+	DefaultStanceParams.EyeHeight = DefaultCharacter->BaseEyeHeight;
+}
+
+FStanceParams UProneMovement::GetStanceParams(EPredictedStance Stance) const
+{
+	// Built from the current properties, so changes at runtime apply on the next stance change
+	FStanceParams Params = DefaultStanceParams;
+	Params.MaxWalkSpeed = MaxWalkSpeed;
+	Params.MaxAcceleration = MaxAcceleration;
+	Params.BrakingDeceleration = BrakingDecelerationWalking;
+	Params.GroundFriction = GroundFriction;
+	Params.BrakingFriction = BrakingFriction;
+
+	switch (Stance)
+	{
+	case EPredictedStance::Crouch:
+		// Height is not allowed to be smaller than radius.
+		Params.HalfHeight = FMath::Max3(0.f, DefaultStanceParams.Radius, GetCrouchedHalfHeight());
+		Params.EyeHeight = CharacterOwner ? CharacterOwner->CrouchedEyeHeight : Params.EyeHeight;
+		Params.MaxWalkSpeed = MaxWalkSpeedCrouched;
+		break;
+	case EPredictedStance::Prone:
+		Params.Radius = PronedRadius;
+		Params.HalfHeight = FMath::Max3(0.f, PronedRadius, PronedHalfHeight);
+		Params.EyeHeight = ProneCharacterOwner ? ProneCharacterOwner->PronedEyeHeight : Params.EyeHeight;
+		Params.MaxWalkSpeed = MaxWalkSpeedProned;
+		Params.MaxAcceleration = MaxAccelerationProned;
+		Params.BrakingDeceleration = BrakingDecelerationProned;
+		Params.GroundFriction = GroundFrictionProned;
+		Params.BrakingFriction = BrakingFrictionProned;
+		break;
+	default:
+		break;
+	}
+	return Params;
+}
+
+EPredictedStance UProneMovement::GetReplicatedStance() const
+{
+	if (IsProned())
+	{
+		return EPredictedStance::Prone;
+	}
+	return IsCrouching() ? EPredictedStance::Crouch : EPredictedStance::Stand;
+}
+
+EPredictedStance UProneMovement::GetDesiredStance() const
+{
+	if (bWantsToProne && CanProneInCurrentState())
+	{
+		return EPredictedStance::Prone;
+	}
+	if (bWantsToCrouch && CanCrouchInCurrentState())
+	{
+		return EPredictedStance::Crouch;
+	}
+	return EPredictedStance::Stand;
+}
+
+bool UProneMovement::ChangeStance(EPredictedStance NewStance, bool bClientSimulation)
+{
+	if (!HasValidData())
+	{
+		return false;
+	}
+
+	const EPredictedStance PrevStance = CapsuleStance;
+	if (NewStance == PrevStance)
 	{
 		if (!bClientSimulation)
 		{
-			ProneCharacterOwner->SetIsProned(true);
+			SetStanceFlags(NewStance);
 		}
-		ProneCharacterOwner->OnStartProne( 0.f, 0.f );
-		SetProneLock(true);
-		return;
+		return true;
 	}
 
-	if (bClientSimulation && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+	UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
+	const FStanceParams PrevParams = GetStanceParams(PrevStance);
+	const FStanceParams NewParams = GetStanceParams(NewStance);
+
+	// Proxy capsules are shrunk, work from the previous stance instead of restoring its size first
+	const bool bSimulatedProxy = bClientSimulation && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy;
+
+	const float ComponentScale = Capsule->GetShapeScale();
+	const float OldUnscaledHalfHeight = bSimulatedProxy ? PrevParams.HalfHeight : Capsule->GetUnscaledCapsuleHalfHeight();
+	const float OldUnscaledRadius = bSimulatedProxy ? PrevParams.Radius : Capsule->GetUnscaledCapsuleRadius();
+	const float HalfHeightAdjust = OldUnscaledHalfHeight - NewParams.HalfHeight;
+	const float ScaledHalfHeightAdjust = HalfHeightAdjust * ComponentScale;
+	const bool bGrowing = NewParams.HalfHeight > OldUnscaledHalfHeight;
+
+	// A shorter capsule that is no wider fits entirely within the previous one, it cannot penetrate anything
+	const bool bContained = !bGrowing && NewParams.Radius <= OldUnscaledRadius;
+
+	if (!bClientSimulation && bGrowing)
 	{
-		// restore collision size before prone
-		const ACharacter* DefaultCharacter = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>();
-		CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleRadius(), DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight());
-		bShrinkProxyCapsule = true;
-	}
+		// Recently blocked here, don't test again yet
+		FProneEncroachmentCache& Cache = EncroachmentCache[(uint8)NewStance];
+		if (IsEncroachmentCached(Cache))
+		{
+			return false;
+		}
 
-	// Change collision size to prone dimensions
-	const float ComponentScale = CharacterOwner->GetCapsuleComponent()->GetShapeScale();
-	const float OldUnscaledHalfHeight = CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
-	const float OldUnscaledRadius = CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleRadius();
+		// Single query against the final capsule, regardless of the stances in between
+		if (!MoveToFitStance(NewParams))
+		{
+			CacheEncroachment(Cache);
+			return false;
+		}
+		Cache.Invalidate();
+	}
 
-	// Height is not allowed to be smaller than radius.
-	const float ClampedPronedHalfHeight = FMath::Max3(0.f, PronedRadius, PronedHalfHeight);
-	CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(PronedRadius, ClampedPronedHalfHeight);
-	float HalfHeightAdjust = (OldUnscaledHalfHeight - ClampedPronedHalfHeight);
-	float ScaledHalfHeightAdjust = HalfHeightAdjust * ComponentScale;
+	// Now call SetCapsuleSize() to cause touch/untouch events and actually resize the capsule
+	if (bSimulatedProxy)
+	{
+		// Straight to the shrunk proxy size, rather than resizing again in AdjustProxyCapsuleSize()
+		float ProxyRadius, ProxyHalfHeight;
+		GetProxyCapsuleSize(NewParams, ProxyRadius, ProxyHalfHeight);
+		Capsule->SetCapsuleSize(ProxyRadius, ProxyHalfHeight);
+		bShrinkProxyCapsule = false;
+	}
+	else
+	{
+		Capsule->SetCapsuleSize(NewParams.Radius, NewParams.HalfHeight);
+	}
 
-	if( !bClientSimulation )
+	if (!bClientSimulation)
 	{
-		// Proned to a larger height? (this is rare)
-		if (ClampedPronedHalfHeight > OldUnscaledHalfHeight)
+		if (!bGrowing && bCrouchMaintainsBaseLocation)
 		{
-			FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(ProneTrace), false, CharacterOwner);
-			FCollisionResponseParams ResponseParam;
-			InitCollisionParams(CapsuleParams, ResponseParam);
-			const bool bEncroached = GetWorld()->OverlapBlockingTestByChannel(UpdatedComponent->GetComponentLocation() - FVector(0.f,0.f,ScaledHalfHeightAdjust), FQuat::Identity,
-				UpdatedComponent->GetCollisionObjectType(), GetPawnCapsuleCollisionShape(SHRINK_None), CapsuleParams, ResponseParam);
-
-			// If encroached, cancel
-			if( bEncroached )
+			// Moving a contained capsule down to the previous base stays within the previous capsule, no need to sweep
+			if (bContained)
 			{
-				CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(OldUnscaledRadius, OldUnscaledHalfHeight);
-				return;
+				INC_DWORD_STAT(STAT_StanceMoveSweepsSkipped);
 			}
-		}
 
-		if (bCrouchMaintainsBaseLocation)
-		{
 			// Intentionally not using MoveUpdatedComponent, where a horizontal plane constraint would prevent the base of the capsule from staying at the same spot.
-			UpdatedComponent->MoveComponent(FVector(0.f, 0.f, -ScaledHalfHeightAdjust), UpdatedComponent->GetComponentQuat(), true, nullptr, EMoveComponentFlags::MOVECOMP_NoFlags, ETeleportType::TeleportPhysics);
+			UpdatedComponent->MoveComponent(FVector(0.f, 0.f, -ScaledHalfHeightAdjust), UpdatedComponent->GetComponentQuat(), !bContained, nullptr, EMoveComponentFlags::MOVECOMP_NoFlags, ETeleportType::TeleportPhysics);
 		}
 
-		ProneCharacterOwner->SetIsProned(true);
+		SetStanceFlags(NewStance);
 	}
 
-	// Our capsule is growing during prone, test for encroaching from radius
-	FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(ProneTrace), false, CharacterOwner);
-	FCollisionResponseParams ResponseParam;
-	InitCollisionParams(CapsuleParams, ResponseParam);
-	FHitResult Hit;
-	const FVector Start = UpdatedComponent->GetComponentLocation() - FVector(0.f,0.f,ScaledHalfHeightAdjust);
-	const FVector End = UpdatedComponent->GetComponentLocation() - FVector(0.f,0.f,ScaledHalfHeightAdjust * 1.01f);
-	if (GetWorld()->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, UpdatedComponent->GetCollisionObjectType(), FCollisionShape::MakeCapsule(PronedRadius, PronedHalfHeight), CapsuleParams, ResponseParam))
+	CapsuleStance = NewStance;
+
+	// Our capsule is wider while shrinking, test for encroaching from radius
+	if (bContained)
 	{
-		if (Hit.bStartPenetrating)
+		INC_DWORD_STAT(STAT_StancePenetrationSweepsSkipped);
+	}
+	else if (!bGrowing)
+	{
+		FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(ProneTrace), false, CharacterOwner);
+		FCollisionResponseParams ResponseParam;
+		InitCollisionParams(CapsuleParams, ResponseParam);
+		FHitResult Hit;
+		const FVector Start = UpdatedComponent->GetComponentLocation();
+		const FVector End = Start - FVector(0.f, 0.f, ScaledHalfHeightAdjust * 0.01f);
+		if (GetWorld()->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, UpdatedComponent->GetCollisionObjectType(), GetPawnCapsuleCollisionShape(SHRINK_None), CapsuleParams, ResponseParam))
 		{
-			HandleImpact(Hit);
-			SlideAlongSurface(FVector::DownVector, 1.f, Hit.Normal, Hit, true);
-
 			if (Hit.bStartPenetrating)
 			{
-				OnCharacterStuckInGeometry(&Hit);
+				HandleImpact(Hit);
+				SlideAlongSurface(FVector::DownVector, 1.f, Hit.Normal, Hit, true);
+
+				if (Hit.bStartPenetrating)
+				{
+					OnCharacterStuckInGeometry(&Hit);
+				}
 			}
 		}
 	}
-	
-	bForceNextFloorCheck = true;
 
-	SetProneLock(true);
+	// Same radius and the same base location on a walkable floor, the floor cannot have changed
+	const bool bSameFloor = !bClientSimulation && bContained && bCrouchMaintainsBaseLocation &&
+		NewParams.Radius == OldUnscaledRadius && IsMovingOnGround() && CurrentFloor.IsWalkableFloor();
+	if (bSameFloor)
+	{
+		INC_DWORD_STAT(STAT_StanceFloorChecksSkipped);
+	}
+	else
+	{
+		bForceNextFloorCheck = true;
+	}
 
-	// OnStartProne takes the change from the Default size, not the current one (though they are usually the same).
-	const float MeshAdjust = ScaledHalfHeightAdjust;
-	const ACharacter* DefaultCharacter = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>();
-	HalfHeightAdjust = (DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight() - ClampedPronedHalfHeight);
-	ScaledHalfHeightAdjust = HalfHeightAdjust * ComponentScale;
+	if (NewStance == EPredictedStance::Prone)
+	{
+		SetProneLock(true);
+	}
 
+	const float MeshAdjust = ScaledHalfHeightAdjust;
 	AdjustProxyCapsuleSize();
-	ProneCharacterOwner->OnStartProne( HalfHeightAdjust, ScaledHalfHeightAdjust );
+	NotifyStanceChanged(PrevStance, NewStance);
 
 	// Don't smooth this change in mesh position
 	if ((bClientSimulation && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy) || (IsNetMode(NM_ListenServer) && CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy))
@@ -287,156 +434,242 @@ void UProneMovement::Prone(bool bClientSimulation)
 			ClientData->OriginalMeshTranslationOffset = ClientData->MeshTranslationOffset;
 		}
 	}
+
+	return true;
 }
 
-void UProneMovement::UnProne(bool bClientSimulation)
+bool UProneMovement::MoveToFitStance(const FStanceParams& Stance)
 {
-	if (!HasValidData())
-	{
-		return;
-	}
-
-	if (IsProneLocked())
-	{
-		return;
-	}
-
-	AProneCharacter* DefaultCharacter = ProneCharacterOwner->GetClass()->GetDefaultObject<AProneCharacter>();
-
-	// See if collision is already at desired size.
-	if (CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight() == DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight() &&
-		CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleRadius() == DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleRadius())
-	{
-		if (!bClientSimulation)
-		{
-			ProneCharacterOwner->SetIsProned(false);
-		}
-		ProneCharacterOwner->OnEndProne( 0.f, 0.f );
-		return;
-	}
-
-	const float CurrentPronedHalfHeight = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
-
-	const float ComponentScale = CharacterOwner->GetCapsuleComponent()->GetShapeScale();
-	const float OldUnscaledHalfHeight = CharacterOwner->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
-	const float HalfHeightAdjust = DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight() - OldUnscaledHalfHeight;
-	const float ScaledHalfHeightAdjust = HalfHeightAdjust * ComponentScale;
+	const UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
+	const float ComponentScale = Capsule->GetShapeScale();
+	const float CurrentHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
 	const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
 
-	// Grow to unproned size.
-	check(CharacterOwner->GetCapsuleComponent());
+	// Try to stay in place and see if the larger capsule fits. We use a slightly taller capsule to avoid penetration.
+	const UWorld* MyWorld = GetWorld();
+	constexpr float SweepInflation = UE_KINDA_SMALL_NUMBER * 10.f;
+	FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(ProneTrace), false, CharacterOwner);
+	FCollisionResponseParams ResponseParam;
+	InitCollisionParams(CapsuleParams, ResponseParam);
 
-	if( !bClientSimulation )
-	{
-		// Try to stay in place and see if the larger capsule fits. We use a slightly taller capsule to avoid penetration.
-		const UWorld* MyWorld = GetWorld();
-		constexpr float SweepInflation = UE_KINDA_SMALL_NUMBER * 10.f;
-		FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(ProneTrace), false, CharacterOwner);
-		FCollisionResponseParams ResponseParam;
-		InitCollisionParams(CapsuleParams, ResponseParam);
+	const FCollisionShape StanceCapsuleShape = FCollisionShape::MakeCapsule(Stance.Radius * ComponentScale, Stance.HalfHeight * ComponentScale + SweepInflation);
+	const ECollisionChannel CollisionChannel = UpdatedComponent->GetCollisionObjectType();
+	bool bEncroached = true;
 
-		// Compensate for the difference between current capsule size and standing size
-		const FCollisionShape StandingCapsuleShape = GetPawnCapsuleCollisionShape(SHRINK_HeightCustom, -SweepInflation - ScaledHalfHeightAdjust); // Shrink by negative amount, so actually grow it.
-		const ECollisionChannel CollisionChannel = UpdatedComponent->GetCollisionObjectType();
-		bool bEncroached = true;
+	if (!bCrouchMaintainsBaseLocation)
+	{
+		// Expand in place
+		bEncroached = MyWorld->OverlapBlockingTestByChannel(PawnLocation, FQuat::Identity, CollisionChannel, StanceCapsuleShape, CapsuleParams, ResponseParam);
 
-		if (!bCrouchMaintainsBaseLocation)
+		if (bEncroached)
 		{
-			// Expand in place
-			bEncroached = MyWorld->OverlapBlockingTestByChannel(PawnLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
-		
-			if (bEncroached)
+			// Try adjusting capsule position to see if we can avoid encroachment.
+			if (StanceCapsuleShape.GetCapsuleHalfHeight() > CurrentHalfHeight)
 			{
-				// Try adjusting capsule position to see if we can avoid encroachment.
-				if (ScaledHalfHeightAdjust > 0.f)
+				// Shrink to a short capsule, sweep down to base to find where that would hit something, and then try to grow from there.
+				float PawnRadius, PawnHalfHeight;
+				Capsule->GetScaledCapsuleSize(PawnRadius, PawnHalfHeight);
+				const float ShrinkHalfHeight = PawnHalfHeight - PawnRadius;
+				const float TraceDist = PawnHalfHeight - ShrinkHalfHeight;
+				const FVector Down = FVector(0.f, 0.f, -TraceDist);
+
+				FHitResult Hit(1.f);
+				const FCollisionShape ShortCapsuleShape = GetPawnCapsuleCollisionShape(SHRINK_HeightCustom, ShrinkHalfHeight);
+				MyWorld->SweepSingleByChannel(Hit, PawnLocation, PawnLocation + Down, FQuat::Identity, CollisionChannel, ShortCapsuleShape, CapsuleParams);
+				if (Hit.bStartPenetrating)
 				{
-					// Shrink to a short capsule, sweep down to base to find where that would hit something, and then try to stand up from there.
-					float PawnRadius, PawnHalfHeight;
-					CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(PawnRadius, PawnHalfHeight);
-					const float ShrinkHalfHeight = PawnHalfHeight - PawnRadius;
-					const float TraceDist = PawnHalfHeight - ShrinkHalfHeight;
-					const FVector Down = FVector(0.f, 0.f, -TraceDist);
-
-					FHitResult Hit(1.f);
-					const FCollisionShape ShortCapsuleShape = GetPawnCapsuleCollisionShape(SHRINK_HeightCustom, ShrinkHalfHeight);
-					MyWorld->SweepSingleByChannel(Hit, PawnLocation, PawnLocation + Down, FQuat::Identity, CollisionChannel, ShortCapsuleShape, CapsuleParams);
-					if (Hit.bStartPenetrating)
-					{
-						bEncroached = true;
-					}
-					else
+					bEncroached = true;
+				}
+				else
+				{
+					// Compute where the base of the sweep ended up, and see if we can fit there
+					const float DistanceToBase = (Hit.Time * TraceDist) + ShortCapsuleShape.Capsule.HalfHeight;
+					const FVector NewLoc = FVector(PawnLocation.X, PawnLocation.Y, PawnLocation.Z - DistanceToBase + StanceCapsuleShape.Capsule.HalfHeight + SweepInflation + MIN_FLOOR_DIST / 2.f);
+					bEncroached = MyWorld->OverlapBlockingTestByChannel(NewLoc, FQuat::Identity, CollisionChannel, StanceCapsuleShape, CapsuleParams, ResponseParam);
+					if (!bEncroached)
 					{
-						// Compute where the base of the sweep ended up, and see if we can stand there
-						const float DistanceToBase = (Hit.Time * TraceDist) + ShortCapsuleShape.Capsule.HalfHeight;
-						const FVector NewLoc = FVector(PawnLocation.X, PawnLocation.Y, PawnLocation.Z - DistanceToBase + StandingCapsuleShape.Capsule.HalfHeight + SweepInflation + MIN_FLOOR_DIST / 2.f);
-						bEncroached = MyWorld->OverlapBlockingTestByChannel(NewLoc, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
-						if (!bEncroached)
-						{
-							// Intentionally not using MoveUpdatedComponent, where a horizontal plane constraint would prevent the base of the capsule from staying at the same spot.
-							UpdatedComponent->MoveComponent(NewLoc - PawnLocation, UpdatedComponent->GetComponentQuat(), false, nullptr, EMoveComponentFlags::MOVECOMP_NoFlags, ETeleportType::TeleportPhysics);
-						}
+						// Intentionally not using MoveUpdatedComponent, where a horizontal plane constraint would prevent the base of the capsule from staying at the same spot.
+						UpdatedComponent->MoveComponent(NewLoc - PawnLocation, UpdatedComponent->GetComponentQuat(), false, nullptr, EMoveComponentFlags::MOVECOMP_NoFlags, ETeleportType::TeleportPhysics);
 					}
 				}
 			}
 		}
-		else
-		{
-			// Expand while keeping base location the same.
-			FVector StandingLocation = PawnLocation + FVector(0.f, 0.f, StandingCapsuleShape.GetCapsuleHalfHeight() - CurrentPronedHalfHeight);
-			bEncroached = MyWorld->OverlapBlockingTestByChannel(StandingLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
+	}
+	else
+	{
+		// Expand while keeping base location the same.
+		FVector StanceLocation = PawnLocation + FVector(0.f, 0.f, StanceCapsuleShape.GetCapsuleHalfHeight() - CurrentHalfHeight);
+		bEncroached = MyWorld->OverlapBlockingTestByChannel(StanceLocation, FQuat::Identity, CollisionChannel, StanceCapsuleShape, CapsuleParams, ResponseParam);
 
-			if (bEncroached)
+		if (bEncroached)
+		{
+			if (IsMovingOnGround())
 			{
-				if (IsMovingOnGround())
+				// Something might be just barely overhead, try moving down closer to the floor to avoid it.
+				constexpr float MinFloorDist = UE_KINDA_SMALL_NUMBER * 10.f;
+				if (CurrentFloor.bBlockingHit && CurrentFloor.FloorDist > MinFloorDist)
 				{
-					// Something might be just barely overhead, try moving down closer to the floor to avoid it.
-					constexpr float MinFloorDist = UE_KINDA_SMALL_NUMBER * 10.f;
-					if (CurrentFloor.bBlockingHit && CurrentFloor.FloorDist > MinFloorDist)
-					{
-						StandingLocation.Z -= CurrentFloor.FloorDist - MinFloorDist;
-						bEncroached = MyWorld->OverlapBlockingTestByChannel(StandingLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
-					}
-				}				
+					StanceLocation.Z -= CurrentFloor.FloorDist - MinFloorDist;
+					bEncroached = MyWorld->OverlapBlockingTestByChannel(StanceLocation, FQuat::Identity, CollisionChannel, StanceCapsuleShape, CapsuleParams, ResponseParam);
+				}
 			}
+		}
 
-			if (!bEncroached)
-			{
-				// Commit the change in location.
-				UpdatedComponent->MoveComponent(StandingLocation - PawnLocation, UpdatedComponent->GetComponentQuat(), false, nullptr, EMoveComponentFlags::MOVECOMP_NoFlags, ETeleportType::TeleportPhysics);
-				bForceNextFloorCheck = true;
-			}
+		if (!bEncroached)
+		{
+			// Commit the change in location.
+			UpdatedComponent->MoveComponent(StanceLocation - PawnLocation, UpdatedComponent->GetComponentQuat(), false, nullptr, EMoveComponentFlags::MOVECOMP_NoFlags, ETeleportType::TeleportPhysics);
 		}
+	}
 
-		// If still encroached then abort.
-		if (bEncroached)
+	return !bEncroached;
+}
+
+void UProneMovement::GetProxyCapsuleSize(const FStanceParams& Stance, float& OutRadius, float& OutHalfHeight) const
+{
+	OutRadius = Stance.Radius;
+	OutHalfHeight = Stance.HalfHeight;
+
+	// Matches AdjustProxyCapsuleSize()
+	const float ComponentScale = CharacterOwner->GetCapsuleComponent()->GetShapeScale();
+	if (ComponentScale > UE_KINDA_SMALL_NUMBER)
+	{
+		const float ProxyRadius = FMath::Max(0.f, Stance.Radius - FMath::Max(0.f, NetProxyShrinkRadius) / ComponentScale);
+		const float ProxyHalfHeight = FMath::Max(0.f, Stance.HalfHeight - FMath::Max(0.f, NetProxyShrinkHalfHeight) / ComponentScale);
+		if (ProxyRadius > 0.f && ProxyHalfHeight > 0.f)
 		{
-			return;
+			OutRadius = ProxyRadius;
+			OutHalfHeight = ProxyHalfHeight;
 		}
+	}
+}
 
-		ProneCharacterOwner->SetIsProned(false);
-	}	
-	else
+void UProneMovement::SetStanceFlags(EPredictedStance Stance)
+{
+	CharacterOwner->bIsCrouched = Stance == EPredictedStance::Crouch;
+	ProneCharacterOwner->SetIsProned(Stance == EPredictedStance::Prone);
+}
+
+void UProneMovement::NotifyStanceChanged(EPredictedStance PrevStance, EPredictedStance NewStance)
+{
+	// Events take the change from the Default size, not the current one (though they are usually the same).
+	const float ComponentScale = CharacterOwner->GetCapsuleComponent()->GetShapeScale();
+	const float DefaultHalfHeight = GetStanceParams(EPredictedStance::Stand).HalfHeight;
+
+	const float PrevHalfHeightAdjust = DefaultHalfHeight - GetStanceParams(PrevStance).HalfHeight;
+	switch (PrevStance)
 	{
-		bShrinkProxyCapsule = true;
+	case EPredictedStance::Crouch:
+		CharacterOwner->OnEndCrouch(PrevHalfHeightAdjust, PrevHalfHeightAdjust * ComponentScale);
+		break;
+	case EPredictedStance::Prone:
+		ProneCharacterOwner->OnEndProne(PrevHalfHeightAdjust, PrevHalfHeightAdjust * ComponentScale);
+		break;
+	default:
+		break;
 	}
 
-	// Now call SetCapsuleSize() to cause touch/untouch events and actually grow the capsule
-	CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleRadius(), DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight(), true);
+	const float NewHalfHeightAdjust = DefaultHalfHeight - GetStanceParams(NewStance).HalfHeight;
+	switch (NewStance)
+	{
+	case EPredictedStance::Crouch:
+		CharacterOwner->OnStartCrouch(NewHalfHeightAdjust, NewHalfHeightAdjust * ComponentScale);
+		break;
+	case EPredictedStance::Prone:
+		ProneCharacterOwner->OnStartProne(NewHalfHeightAdjust, NewHalfHeightAdjust * ComponentScale);
+		break;
+	default:
+		break;
+	}
+}
 
-	const float MeshAdjust = ScaledHalfHeightAdjust;
-	AdjustProxyCapsuleSize();
-	ProneCharacterOwner->OnEndProne( HalfHeightAdjust, ScaledHalfHeightAdjust );
+bool UProneMovement::IsProned() const
+{
+	return ProneCharacterOwner && ProneCharacterOwner->IsProned();
+}
 
-	// Don't smooth this change in mesh position
-	if ((bClientSimulation && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy) || (IsNetMode(NM_ListenServer) && CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy))
+void UProneMovement::Crouch(bool bClientSimulation)
+{
+	if (!HasValidData())
 	{
-		FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
-		if (ClientData)
-		{
-			ClientData->MeshTranslationOffset += FVector(0.f, 0.f, MeshAdjust);
-			ClientData->OriginalMeshTranslationOffset = ClientData->MeshTranslationOffset;
-		}
+		return;
+	}
+
+	if (bClientSimulation)
+	{
+		ChangeStance(GetReplicatedStance(), true);
+		return;
+	}
+
+	if (!CanCrouchInCurrentState() || (CapsuleStance == EPredictedStance::Prone && IsProneLocked()))
+	{
+		return;
 	}
+
+	ChangeStance(EPredictedStance::Crouch);
+}
+
+void UProneMovement::UnCrouch(bool bClientSimulation)
+{
+	if (!HasValidData())
+	{
+		return;
+	}
+
+	if (bClientSimulation)
+	{
+		ChangeStance(GetReplicatedStance(), true);
+		return;
+	}
+
+	if (CapsuleStance == EPredictedStance::Crouch)
+	{
+		ChangeStance(EPredictedStance::Stand);
+	}
+}
+
+void UProneMovement::Prone(bool bClientSimulation)
+{
+	if (!HasValidData())
+	{
+		return;
+	}
+
+	if (bClientSimulation)
+	{
+		ChangeStance(GetReplicatedStance(), true);
+		return;
+	}
+
+	if (!CanProneInCurrentState())
+	{
+		return;
+	}
+
+	ChangeStance(EPredictedStance::Prone);
+}
+
+void UProneMovement::UnProne(bool bClientSimulation)
+{
+	if (!HasValidData())
+	{
+		return;
+	}
+
+	if (bClientSimulation)
+	{
+		ChangeStance(GetReplicatedStance(), true);
+		return;
+	}
+
+	if (IsProneLocked() || CapsuleStance != EPredictedStance::Prone)
+	{
+		return;
+	}
+
+	// Change directly to crouch if wanted, rather than standing then crouching
+	const bool bCrouch = bWantsToCrouch && CanCrouchInCurrentState();
+	ChangeStance(bCrouch ? EPredictedStance::Crouch : EPredictedStance::Stand);
 }
 
 bool UProneMovement::CanProneInCurrentState() const
@@ -446,53 +679,33 @@ bool UProneMovement::CanProneInCurrentState() const
 
 void UProneMovement::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 {
-	// Proxies get replicated crouch state.
+	// Proxies get replicated crouch and Prone state.
 	if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
 	{
-		// Check for a change in crouch state. Players toggle crouch by changing bWantsToCrouch.
-		const bool bIsCrouching = IsCrouching();
-		if (bIsCrouching && (!bWantsToCrouch || !CanCrouchInCurrentState()))
+		// Check if prone lock timer has expired
+		if (bProneLocked && !IsProneLockOnTimer())
 		{
-			UnCrouch(false);
+			SetProneLock(false);
 		}
-		else if (!bIsCrouching && bWantsToCrouch && CanCrouchInCurrentState())
+
+		// Players toggle stances by changing bWantsToCrouch and bWantsToProne, the one requested last takes precedence
+		if (bWantsToCrouch && bWantsToProne)
 		{
 			if (IsProned())
 			{
 				bWantsToProne = false;
-				UnProne(false);
 			}
-			if (!IsProned())
+			else
 			{
-				// Potential prone lock
-				Crouch(false);
+				bWantsToCrouch = false;
 			}
 		}
-	}
 
-	// Proxies get replicated Prone state.
-	if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
-	{
-		// Check if prone lock timer has expired
-		if (bProneLocked && !IsProneLockOnTimer())
+		// Change directly to the desired stance, e.g. Prone ➜ Crouch doesn't stand up in between
+		const EPredictedStance DesiredStance = GetDesiredStance();
+		if (DesiredStance != CapsuleStance && (CapsuleStance != EPredictedStance::Prone || !IsProneLocked()))
 		{
-			SetProneLock(false);
-		}
-		
-		// Check for a change in Prone state. Players toggle Prone by changing bWantsToProne.
-		const bool bIsProned = IsProned();
-		if (bIsProned && (!bWantsToProne || !CanProneInCurrentState()))
-		{
-			UnProne(false);
-		}
-		else if (!bIsProned && bWantsToProne && CanProneInCurrentState())
-		{
-			if (IsCrouching())
-			{
-				bWantsToCrouch = false;
-				UnCrouch(false);
-			}
-			Prone(false);
+			ChangeStance(DesiredStance);
 		}
 	}
 }
@@ -514,6 +727,9 @@ void UProneMovement::UpdateCharacterStateAfterMovement(float DeltaSeconds)
 
 bool UProneMovement::ClientUpdatePositionAfterServerUpdate()
 {
+	// We were corrected, blocked attempts may not have been blocked on the server
+	InvalidateEncroachmentCache();
+
 	const bool bRealProne = bWantsToProne;
 	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
 	bWantsToProne = bRealProne;
@@ -521,6 +737,24 @@ bool UProneMovement::ClientUpdatePositionAfterServerUpdate()
 	return bResult;
 }
 
+void UProneMovement::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+	const FVector& NewAccel)
+{
+	// Replays use the timestamp of the saved move, the server already uses CurrentClientTimeStamp
+	const bool bReplaying = CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy;
+	if (bReplaying)
+	{
+		ReplayingMoveTimestamp = ClientTimeStamp;
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+
+	if (bReplaying)
+	{
+		ReplayingMoveTimestamp = -1.f;
+	}
+}
+
 void FSavedMove_Character_Prone::Clear()
 {
 	Super::Clear();
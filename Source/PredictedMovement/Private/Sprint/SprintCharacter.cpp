@@ -36,6 +36,11 @@ void ASprintCharacter::SetIsSprinting(bool bNewSprinting)
 	{
 		bIsSprinting = bNewSprinting;
 
+		if (SprintMovement)
+		{
+			SprintMovement->InvalidateSprintSnapshot();
+		}
+
 		if (HasAuthority())
 		{
 			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, bIsSprinting, this);  // Push-model
@@ -55,7 +60,7 @@ bool ASprintCharacter::IsSprintWithinAllowableInputAngle() const
 
 bool ASprintCharacter::IsSprintingInEffect() const
 {
-	return IsSprintingAtSpeed() && IsSprintWithinAllowableInputAngle();
+	return SprintMovement && SprintMovement->IsSprintingInEffect();
 }
 
 void ASprintCharacter::OnRep_IsSprinting()
@@ -66,7 +66,58 @@ void USprintMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
 	SprintCharacterOwner = Cast<ASprintCharacter>(PawnOwner);
 }
 
+const FSprintSnapshot& USprintMovement::GetSprintSnapshot() const
+{
+	// Velocity and acceleration change between substeps, everything else invalidates the snapshot explicitly
+	if (!SprintSnapshot.bValid || SprintSnapshot.Velocity != Velocity || SprintSnapshot.Acceleration != Acceleration)
+	{
+		SprintSnapshot.Velocity = Velocity;
+		SprintSnapshot.Acceleration = Acceleration;
+		SprintSnapshot.bValid = true;
+		SprintSnapshot.bIsSprinting = SprintCharacterOwner && SprintCharacterOwner->IsSprinting();
+
+		// Evaluated on demand, most queries only want IsSprinting()
+		SprintSnapshot.bHasSprintingAtSpeed = false;
+		SprintSnapshot.bHasInputAngle = false;
+	}
+	return SprintSnapshot;
+}
+
+void USprintMovement::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
+{
+	InvalidateSprintSnapshot();
+
+	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+}
+
+void USprintMovement::Crouch(bool bClientSimulation)
+{
+	Super::Crouch(bClientSimulation);
+
+	// Walk speed used by IsSprintingAtSpeed() may have changed
+	InvalidateSprintSnapshot();
+}
+
+void USprintMovement::UnCrouch(bool bClientSimulation)
+{
+	Super::UnCrouch(bClientSimulation);
+
+	// Walk speed used by IsSprintingAtSpeed() may have changed
+	InvalidateSprintSnapshot();
+}
+
 bool USprintMovement::IsSprintingAtSpeed() const
+{
+	const FSprintSnapshot& Snapshot = GetSprintSnapshot();
+	if (!Snapshot.bHasSprintingAtSpeed)
+	{
+		SprintSnapshot.bIsSprintingAtSpeed = CalcIsSprintingAtSpeed();
+		SprintSnapshot.bHasSprintingAtSpeed = true;
+	}
+	return Snapshot.bIsSprintingAtSpeed;
+}
+
+bool USprintMovement::CalcIsSprintingAtSpeed() const
 {
 	if (!IsSprinting())
 	{
@@ -132,11 +183,12 @@ void USprintMovement::SetMaxInputAngleSprint(float InMaxAngleSprint)
 {
 	MaxInputAngleSprint = FMath::Clamp(InMaxAngleSprint, 0.f, 180.0f);
 	MaxInputNormalSprint = FMath::Cos(FMath::DegreesToRadians(MaxInputAngleSprint));
+	InvalidateSprintSnapshot();
 }
 
 bool USprintMovement::IsSprinting() const
 {
-	return SprintCharacterOwner && SprintCharacterOwner->IsSprinting();
+	return GetSprintSnapshot().bIsSprinting;
 }
 
 void USprintMovement::Sprint(bool bClientSimulation)
@@ -155,6 +207,7 @@ void USprintMovement::Sprint(bool bClientSimulation)
 	{
 		SprintCharacterOwner->SetIsSprinting(true);
 	}
+	InvalidateSprintSnapshot();
 	SprintCharacterOwner->OnStartSprint();
 }
 
@@ -169,6 +222,7 @@ void USprintMovement::UnSprint(bool bClientSimulation)
 	{
 		SprintCharacterOwner->SetIsSprinting(false);
 	}
+	InvalidateSprintSnapshot();
 	SprintCharacterOwner->OnEndSprint();
 }
 
@@ -188,6 +242,21 @@ bool USprintMovement::CanSprintInCurrentState() const
 }
 
 bool USprintMovement::IsSprintWithinAllowableInputAngle() const
+{
+	const FSprintSnapshot& Snapshot = GetSprintSnapshot();
+
+	// The angle also depends on our facing, which can change without velocity or acceleration changing
+	const FQuat Rotation = UpdatedComponent ? UpdatedComponent->GetComponentQuat() : FQuat::Identity;
+	if (!Snapshot.bHasInputAngle || !Snapshot.Rotation.Equals(Rotation, 0.f))
+	{
+		SprintSnapshot.Rotation = Rotation;
+		SprintSnapshot.bIsWithinAllowableInputAngle = CalcIsSprintWithinAllowableInputAngle();
+		SprintSnapshot.bHasInputAngle = true;
+	}
+	return Snapshot.bIsWithinAllowableInputAngle;
+}
+
+bool USprintMovement::CalcIsSprintWithinAllowableInputAngle() const
 {
 	if (!bRestrictSprintInputAngle && MaxInputAngleSprint <= 0.f)
 	{
@@ -3,10 +3,13 @@
 
 #include "Stamina/StaminaMovement.h"
 
+#include "System/PredictedMovementStats.h"
 #include "GameFramework/Character.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(StaminaMovement)
 
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Stamina Correction Threshold"), STAT_StaminaCorrectionThreshold, STATGROUP_PredictedMovement);
+
 void FStaminaMoveResponseDataContainer::ServerFillResponseData(
 	const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment)
 {
@@ -62,6 +65,26 @@ UStaminaMovement::UStaminaMovement(const FObjectInitializer& ObjectInitializer)
 	NetworkStaminaCorrectionThreshold = 2.f;
 }
 
+void UStaminaMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
+{
+	if (PawnOwner)
+	{
+		PawnOwner->ReceiveControllerChangedDelegate.RemoveDynamic(this, &ThisClass::OnPawnControllerChanged);
+	}
+
+	Super::SetUpdatedComponent(NewUpdatedComponent);
+
+	if (PawnOwner)
+	{
+		PawnOwner->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &ThisClass::OnPawnControllerChanged);
+	}
+}
+
+void UStaminaMovement::OnPawnControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	AdaptiveStaminaCorrectionState.Reset();
+}
+
 void UStaminaMovement::SetStamina(float NewStamina)
 {
 	const float PrevStamina = Stamina;
@@ -242,20 +265,26 @@ bool UStaminaMovement::ServerCheckClientError(float ClientTimeStamp, float Delta
 	// ServerMovePacked_ServerReceive ➜ ServerMove_HandleMoveData ➜ ServerMove_PerformMovement
 	// ➜ ServerMoveHandleClientError ➜ ServerCheckClientError
 	
-    if (Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode))
-    {
-        return true;
-    }
-    
 	// This will trigger a client correction if the Stamina value in the Client differs NetworkStaminaCorrectionThreshold (2.f default) units from the one in the server
 	// Desyncs can happen if we set the Stamina directly in Gameplay code (ie: GAS)
+	// Checked before Super so the adaptive threshold is sampled on every move, not only moves without positional error
     const FStaminaNetworkMoveData* CurrentMoveData = static_cast<const FStaminaNetworkMoveData*>(GetCurrentNetworkMoveData());
-    if (!FMath::IsNearlyEqual(CurrentMoveData->Stamina, Stamina, NetworkStaminaCorrectionThreshold))
+	const float StaminaError = FMath::Abs(CurrentMoveData->Stamina - Stamina);
+	const bool bStaminaError = StaminaError > GetNetworkStaminaCorrectionThreshold();
+
+	if (AdaptiveStaminaCorrection.bEnabled && NetworkStaminaCorrectionThreshold > 0.f)
+	{
+		AdaptiveStaminaCorrectionState.AddSample(AdaptiveStaminaCorrection,
+			StaminaError / NetworkStaminaCorrectionThreshold, bStaminaError, DeltaTime);
+		SET_FLOAT_STAT(STAT_StaminaCorrectionThreshold, GetNetworkStaminaCorrectionThreshold());
+	}
+
+    if (Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode))
     {
         return true;
     }
     
-    return false;
+    return bStaminaError;
 }
 
 FNetworkPredictionData_Client* UStaminaMovement::GetPredictionData_Client() const
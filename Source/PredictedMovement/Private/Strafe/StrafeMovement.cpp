@@ -4,6 +4,7 @@
 #include "Strafe/StrafeMovement.h"
 
 #include "Strafe/StrafeCharacter.h"
+#include "Curves/CurveFloat.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(StrafeMovement)
 
@@ -16,7 +17,15 @@ UStrafeMovement::UStrafeMovement(const FObjectInitializer& ObjectInitializer)
 	GroundFrictionStrafing = 12.f;
 	BrakingFrictionStrafing = 4.f;
 
+	bUseDirectionalStrafeSpeed = false;
+	StrafeSpeedForwardMultiplier = 1.f;
+	StrafeSpeedLateralMultiplier = 0.9f;
+	StrafeSpeedBackwardMultiplier = 0.75f;
+	StrafeSpeedCurve = nullptr;
+
 	bWantsToStrafe = false;
+
+	BakeStrafeSpeedTable();
 }
 
 bool UStrafeMovement::HasValidData() const
@@ -29,6 +38,8 @@ void UStrafeMovement::PostLoad()
 	Super::PostLoad();
 
 	StrafeCharacterOwner = Cast<AStrafeCharacter>(PawnOwner);
+
+	BakeStrafeSpeedTable();
 }
 
 void UStrafeMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
@@ -36,6 +47,61 @@ void UStrafeMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
 	Super::SetUpdatedComponent(NewUpdatedComponent);
 
 	StrafeCharacterOwner = Cast<AStrafeCharacter>(PawnOwner);
+
+	BakeStrafeSpeedTable();
+}
+
+#if WITH_EDITOR
+void UStrafeMovement::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BakeStrafeSpeedTable();
+}
+#endif
+
+void UStrafeMovement::BakeStrafeSpeedTable()
+{
+	for (int32 Index = 0; Index < StrafeSpeedTableSize; Index++)
+	{
+		// -1 (backward) to 1 (forward)
+		const float Dot = (Index * 2.f / (StrafeSpeedTableSize - 1)) - 1.f;
+		if (StrafeSpeedCurve)
+		{
+			StrafeSpeedTable[Index] = FMath::Max(0.f, StrafeSpeedCurve->GetFloatValue(Dot));
+		}
+		else if (Dot >= 0.f)
+		{
+			StrafeSpeedTable[Index] = FMath::Lerp(StrafeSpeedLateralMultiplier, StrafeSpeedForwardMultiplier, Dot);
+		}
+		else
+		{
+			StrafeSpeedTable[Index] = FMath::Lerp(StrafeSpeedLateralMultiplier, StrafeSpeedBackwardMultiplier, -Dot);
+		}
+	}
+}
+
+float UStrafeMovement::GetStrafeSpeedMultiplier() const
+{
+	if (!bUseDirectionalStrafeSpeed || !UpdatedComponent)
+	{
+		return 1.f;
+	}
+
+	// Input direction is what the client sends, fall back to velocity when there is no input
+	const FVector& Direction = Acceleration.IsNearlyZero() ? Velocity : Acceleration;
+	const FVector2D Direction2D = FVector2D(Direction).GetSafeNormal();
+	if (Direction2D.IsZero())
+	{
+		return StrafeSpeedTable[StrafeSpeedTableSize - 1];
+	}
+
+	const FVector2D Forward2D = FVector2D(UpdatedComponent->GetForwardVector()).GetSafeNormal();
+	const float Dot = FMath::Clamp<float>(Direction2D | Forward2D, -1.f, 1.f);
+
+	// Nearest sample, small differences between client and server rarely cross a sample boundary
+	const int32 Index = FMath::RoundToInt((Dot + 1.f) * 0.5f * (StrafeSpeedTableSize - 1));
+	return StrafeSpeedTable[FMath::Clamp(Index, 0, StrafeSpeedTableSize - 1)];
 }
 
 float UStrafeMovement::GetMaxAcceleration() const
@@ -51,7 +117,7 @@ float UStrafeMovement::GetMaxSpeed() const
 {
 	if (IsStrafing())
 	{
-		return MaxWalkSpeedStrafing;
+		return MaxWalkSpeedStrafing * GetStrafeSpeedMultiplier();
 	}
 	return Super::GetMaxSpeed();
 }
@@ -0,0 +1,52 @@
+// Copyright (c) Jared Taylor
+
+
+#include "System/AdaptiveCorrection.h"
+
+#include "System/PredictedMovementStats.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AdaptiveCorrection)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Adaptive Correction Samples (Widened)"), STAT_AdaptiveCorrectionWidened, STATGROUP_PredictedMovement);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Adaptive Correction Samples (Tightened)"), STAT_AdaptiveCorrectionTightened, STATGROUP_PredictedMovement);
+
+void FAdaptiveCorrectionState::AddSample(const FAdaptiveCorrectionParams& Params, float NormalizedError,
+	bool bCorrected, float DeltaTime)
+{
+	if (!Params.bEnabled || DeltaTime <= 0.f)
+	{
+		return;
+	}
+
+	// Weight of this sample, so that the statistics decay over SampleWindow regardless of the client's move rate
+	const float Alpha = 1.f - FMath::Exp(-DeltaTime / FMath::Max(Params.SampleWindow, UE_KINDA_SMALL_NUMBER));
+
+	// Exponentially weighted mean and variance of the error
+	const float Diff = NormalizedError - ErrorMean;
+	ErrorMean += Alpha * Diff;
+	ErrorVariance = (1.f - Alpha) * (ErrorVariance + Alpha * Diff * Diff);
+
+	// Corrections per second
+	CorrectionRate += Alpha * ((bCorrected ? 1.f / DeltaTime : 0.f) - CorrectionRate);
+
+	// The threshold this connection needs to cover its typical error envelope
+	float DesiredScale = ErrorMean + Params.ErrorDeviations * FMath::Sqrt(ErrorVariance);
+
+	// Correction storm, widen further in proportion to how far over budget we are
+	if (Params.TargetCorrectionRate > 0.f && CorrectionRate > Params.TargetCorrectionRate)
+	{
+		DesiredScale = FMath::Max(DesiredScale, Scale * (CorrectionRate / Params.TargetCorrectionRate));
+	}
+
+	DesiredScale = FMath::Clamp(DesiredScale, Params.MinScale, FMath::Max(Params.MinScale, Params.MaxScale));
+	Scale = FMath::FInterpConstantTo(Scale, DesiredScale, DeltaTime, Params.ScaleInterpSpeed);
+
+	if (Scale > 1.f)
+	{
+		INC_DWORD_STAT(STAT_AdaptiveCorrectionWidened);
+	}
+	else if (Scale < 1.f)
+	{
+		INC_DWORD_STAT(STAT_AdaptiveCorrectionTightened);
+	}
+}
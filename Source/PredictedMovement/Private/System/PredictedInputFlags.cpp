@@ -0,0 +1,136 @@
+// Copyright (c) Jared Taylor
+
+
+#include "System/PredictedInputFlags.h"
+
+FPredictedInputFlagRegistry& FPredictedInputFlagRegistry::Get()
+{
+	static FPredictedInputFlagRegistry Registry;
+	return Registry;
+}
+
+const FPredictedInputFlag& FPredictedInputFlagRegistry::Reserve(FName Name, int32 Offset, int32 NumBits)
+{
+	checkf(NumBits > 0 && Offset >= 0 && Offset + NumBits <= 32,
+		TEXT("Predicted input flag %s does not fit within 32 bits (Offset %d, NumBits %d)"), *Name.ToString(), Offset, NumBits);
+
+	if (const TUniquePtr<FPredictedInputFlag>* Existing = Flags.Find(Name))
+	{
+		// Registering the same flag twice is fine, registering a different flag with the same name is not
+		checkf((*Existing)->Offset == Offset && (*Existing)->NumBits == NumBits,
+			TEXT("Predicted input flag %s is already registered with different bits"), *Name.ToString());
+		return **Existing;
+	}
+
+	const FPredictedInputFlag Flag = { Offset, NumBits };
+	ClaimBits(Name, Flag);
+	return *Flags.Add(Name, MakeUnique<FPredictedInputFlag>(Flag));
+}
+
+const FPredictedInputFlag& FPredictedInputFlagRegistry::Allocate(FName Name, int32 NumBits)
+{
+	checkf(NumBits > 0 && NumBits <= 32, TEXT("Predicted input flag %s requests %d bits"), *Name.ToString(), NumBits);
+
+	if (const TUniquePtr<FPredictedInputFlag>* Existing = Flags.Find(Name))
+	{
+		checkf((*Existing)->NumBits == NumBits,
+			TEXT("Predicted input flag %s is already registered with different bits"), *Name.ToString());
+		return **Existing;
+	}
+
+	// Offsets depend on every other allocation, so they can't be handed out after the fact
+	checkf(!bFinalized, TEXT("Predicted input flag %s allocated after the registry was finalized, allocate from a static initializer or StartupModule instead"), *Name.ToString());
+
+	PendingAllocations.Add(Name);
+
+	FPredictedInputFlag Flag;
+	Flag.NumBits = NumBits;
+	return *Flags.Add(Name, MakeUnique<FPredictedInputFlag>(Flag));
+}
+
+void FPredictedInputFlagRegistry::Finalize()
+{
+	if (bFinalized)
+	{
+		return;
+	}
+	bFinalized = true;
+
+	// Sort by name so client and server assign the same bits regardless of registration order
+	PendingAllocations.Sort([](const FName& A, const FName& B) { return A.LexicalLess(B); });
+
+	for (const FName& Name : PendingAllocations)
+	{
+		FPredictedInputFlag& Flag = *Flags.FindChecked(Name);
+
+		for (int32 Offset = 0; Offset + Flag.NumBits <= 32; Offset++)
+		{
+			const uint32 Mask = Flag.GetValueMask() << Offset;
+			if ((UsedMask & Mask) == 0)
+			{
+				Flag.Offset = Offset;
+				break;
+			}
+		}
+
+		checkf(Flag.Offset != INDEX_NONE, TEXT("No room left for predicted input flag %s (%d bits), 0x%08x are in use"),
+			*Name.ToString(), Flag.NumBits, UsedMask);
+
+		ClaimBits(Name, Flag);
+	}
+
+	PendingAllocations.Empty();
+}
+
+const FPredictedInputFlag* FPredictedInputFlagRegistry::Find(FName Name) const
+{
+	const TUniquePtr<FPredictedInputFlag>* Flag = Flags.Find(Name);
+	return Flag ? Flag->Get() : nullptr;
+}
+
+void FPredictedInputFlagRegistry::ClaimBits(FName Name, const FPredictedInputFlag& Flag)
+{
+	const uint32 Mask = Flag.GetMask();
+	checkf((UsedMask & Mask) == 0, TEXT("Predicted input flag %s (0x%08x) collides with flags already in use (0x%08x)"),
+		*Name.ToString(), Mask, UsedMask);
+	UsedMask |= Mask;
+}
+
+void FSavedMove_Character_PredictedInput::Clear()
+{
+	Super::Clear();
+
+	InputFlags.Reset();
+}
+
+bool FSavedMove_Character_PredictedInput::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter,
+	float MaxDelta) const
+{
+	const FSavedMove_Character_PredictedInput* SavedMove = static_cast<const FSavedMove_Character_PredictedInput*>(NewMove.Get());
+
+	if (InputFlags != SavedMove->InputFlags)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FPredictedInputNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove,
+	ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	// Client ➜ Server
+	InputFlags = static_cast<const FSavedMove_Character_PredictedInput&>(ClientMove).InputFlags;
+}
+
+bool FPredictedInputNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
+	UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// Client ➜ Server
+	InputFlags.Serialize(Ar);
+	return !Ar.IsError();
+}
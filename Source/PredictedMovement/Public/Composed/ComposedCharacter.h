@@ -0,0 +1,82 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Character.h"
+#include "ComposedCharacter.generated.h"
+
+class UComposedMovement;
+
+/**
+ * Character for UComposedMovement
+ * Replicates the packed state of every feature to simulated proxies in a single property
+ */
+UCLASS()
+class PREDICTEDMOVEMENT_API AComposedCharacter : public ACharacter
+{
+	GENERATED_BODY()
+
+private:
+	/** Movement component used for movement logic in various movement modes (walking, falling, etc), containing relevant settings and functions to control movement. */
+	UPROPERTY(Category=Character, VisibleAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess = "true"))
+	TObjectPtr<UComposedMovement> ComposedMovement;
+
+public:
+	FORCEINLINE UComposedMovement* GetComposedCharacterMovement() const { return ComposedMovement; }
+
+protected:
+	/** Packed state bits of every feature, set by character movement */
+	UPROPERTY(replicatedUsing=OnRep_SimulatedFeatureState)
+	uint32 SimulatedFeatureState;
+
+public:
+	AComposedCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+public:
+	void SetSimulatedFeatureState(uint32 NewState);
+
+	/** Handle feature state replicated from server */
+	UFUNCTION()
+	virtual void OnRep_SimulatedFeatureState();
+
+	/** Called when the state of any feature changes. Called on non-owned Characters through SimulatedFeatureState replication. */
+	virtual void OnFeatureStateChanged(uint32 PrevState, uint32 NewState);
+
+	/** Event when the state of any feature changes. */
+	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName="On Feature State Changed"))
+	void K2_OnFeatureStateChanged();
+
+public:
+	/** @return true if this character is currently Sprinting */
+	UFUNCTION(BlueprintPure, Category=Character)
+	bool IsSprinting() const;
+
+	/** Request the character to start Sprinting. The request is processed on the next update of the CharacterMovementComponent. */
+	UFUNCTION(BlueprintCallable, Category=Character)
+	void Sprint();
+
+	/** Request the character to stop Sprinting. The request is processed on the next update of the CharacterMovementComponent. */
+	UFUNCTION(BlueprintCallable, Category=Character)
+	void UnSprint();
+
+	/** @return true if this character is currently Strafing */
+	UFUNCTION(BlueprintPure, Category=Character)
+	bool IsStrafing() const;
+
+	/** Request the character to start Strafing. The request is processed on the next update of the CharacterMovementComponent. */
+	UFUNCTION(BlueprintCallable, Category=Character)
+	void Strafe();
+
+	/** Request the character to stop Strafing. The request is processed on the next update of the CharacterMovementComponent. */
+	UFUNCTION(BlueprintCallable, Category=Character)
+	void UnStrafe();
+
+	UFUNCTION(BlueprintPure, Category=Character)
+	float GetStamina() const;
+
+	UFUNCTION(BlueprintPure, Category=Character)
+	bool IsStaminaDrained() const;
+};
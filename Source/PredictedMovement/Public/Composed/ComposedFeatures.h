@@ -0,0 +1,473 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/PredictedMovementComposition.h"
+#include "ComposedFeatures.generated.h"
+
+/**
+ * Sprint as a composable feature, the equivalent of USprintMovement
+ */
+USTRUCT()
+struct PREDICTEDMOVEMENT_API FSprintFeature : public FPredictedMovementFeature
+{
+	GENERATED_BODY()
+
+	FSprintFeature()
+		: bUseMaxAccelerationSprintingOnlyAtSpeed(true)
+		, MaxAccelerationSprinting(1024.f)
+		, MaxWalkSpeedSprinting(600.f)
+		, BrakingDecelerationSprinting(512.f)
+		, GroundFrictionSprinting(8.f)
+		, VelocityCheckMitigatorSprinting(0.98f)
+		, BrakingFrictionSprinting(4.f)
+		, bRestrictSprintInputAngle(true)
+		, MaxInputAngleSprint(50.f)
+		, MaxInputNormalSprint(FMath::Cos(FMath::DegreesToRadians(50.f)))
+		, bWantsToSprint(false)
+		, bIsSprinting(false)
+		, bSprintBlocked(false)
+	{}
+
+	static constexpr int32 NumInputBits = 1;
+	static constexpr int32 NumStateBits = 1;
+
+	/** If true, sprinting acceleration will only be applied when IsSprintingAtSpeed() returns true */
+	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere)
+	bool bUseMaxAccelerationSprintingOnlyAtSpeed;
+
+	/** Max Acceleration (rate of change of velocity) */
+	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float MaxAccelerationSprinting;
+
+	/** The maximum ground speed when Sprinting. */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
+	float MaxWalkSpeedSprinting;
+
+	/** Deceleration when walking and not applying acceleration. @see UCharacterMovementComponent::BrakingDecelerationWalking */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float BrakingDecelerationSprinting;
+
+	/** Setting that affects movement control. @see UCharacterMovementComponent::GroundFriction */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float GroundFrictionSprinting;
+
+	/** Mitigates the walk speed check in IsSprintingAtSpeed(). @see USprintMovement::VelocityCheckMitigatorSprinting */
+	UPROPERTY(Category="Character Movement: Walking", AdvancedDisplay, EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float VelocityCheckMitigatorSprinting;
+
+	/** Friction (drag) coefficient applied when braking. @see UCharacterMovementComponent::BrakingFriction */
+	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float BrakingFrictionSprinting;
+
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(InlineEditConditionToggle))
+	bool bRestrictSprintInputAngle;
+
+	/** Use SetMaxInputAngleSprint() to change this at runtime */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(EditCondition="bRestrictSprintInputAngle", ClampMin="0.0", ClampMax="180.0", UIMin = "0.0", UIMax = "180.0", ForceUnits="degrees"))
+	float MaxInputAngleSprint;
+
+	UPROPERTY(Category="Character Movement: Walking", VisibleAnywhere)
+	float MaxInputNormalSprint;
+
+	/** If true, try to Sprint (or keep Sprinting) on next update. If false, try to stop Sprinting on next update. */
+	uint8 bWantsToSprint:1;
+
+	/** True while Sprinting, replicated to simulated proxies through the packed state bits */
+	uint8 bIsSprinting:1;
+
+	/**
+	 * Set by the composed component to prevent Sprinting, e.g. while stamina is drained
+	 * Must be derived from predicted state before every update, it is not saved or sent
+	 */
+	uint8 bSprintBlocked:1;
+
+	bool IsSprinting() const { return bIsSprinting; }
+
+	void SetMaxInputAngleSprint(float InMaxAngleSprint)
+	{
+		MaxInputAngleSprint = FMath::Clamp(InMaxAngleSprint, 0.f, 180.0f);
+		MaxInputNormalSprint = FMath::Cos(FMath::DegreesToRadians(MaxInputAngleSprint));
+	}
+
+	/** Returns true if the character is allowed to Sprint in the current state. By default it is allowed when walking or falling. */
+	bool CanSprintInCurrentState(const UCharacterMovementComponent& MoveComp) const
+	{
+		return !bSprintBlocked && MoveComp.UpdatedComponent && !MoveComp.UpdatedComponent->IsSimulatingPhysics() &&
+			(MoveComp.IsFalling() || MoveComp.IsMovingOnGround());
+	}
+
+	bool IsSprintingAtSpeed(const UCharacterMovementComponent& MoveComp) const;
+
+	/**
+	 * This check ensures that we are not sprinting backward or sideways, while allowing leeway
+	 * This angle allows sprinting when holding forward, forward left, forward right
+	 * but not left or right or backward)
+	 */
+	bool IsSprintWithinAllowableInputAngle(const UCharacterMovementComponent& MoveComp) const;
+
+	bool IsSprintingInEffect(const UCharacterMovementComponent& MoveComp) const
+	{
+		return IsSprintingAtSpeed(MoveComp) && IsSprintWithinAllowableInputAngle(MoveComp);
+	}
+
+	void Initialize(UCharacterMovementComponent& MoveComp)
+	{
+		SetMaxInputAngleSprint(MaxInputAngleSprint);
+	}
+
+	uint32 GetInputBits() const { return bWantsToSprint ? 1 : 0; }
+	void SetInputBits(uint32 Bits) { bWantsToSprint = (Bits & 1) != 0; }
+
+	uint32 GetStateBits() const { return bIsSprinting ? 1 : 0; }
+	void SetSimulatedStateBits(UCharacterMovementComponent& MoveComp, uint32 Bits)
+	{
+		bIsSprinting = (Bits & 1) != 0;
+		bWantsToSprint = bIsSprinting;
+	}
+
+	void ModifyMaxSpeed(const UCharacterMovementComponent& MoveComp, float& MaxSpeed) const
+	{
+		if (bIsSprinting)
+		{
+			MaxSpeed = MaxWalkSpeedSprinting;
+		}
+	}
+
+	void ModifyMaxAcceleration(const UCharacterMovementComponent& MoveComp, float& MaxAcceleration) const
+	{
+		if (bIsSprinting && (!bUseMaxAccelerationSprintingOnlyAtSpeed || IsSprintingAtSpeed(MoveComp)))
+		{
+			MaxAcceleration = MaxAccelerationSprinting;
+		}
+	}
+
+	void ModifyMaxBrakingDeceleration(const UCharacterMovementComponent& MoveComp, float& MaxBrakingDeceleration) const
+	{
+		if (bIsSprinting && IsSprintingAtSpeed(MoveComp))
+		{
+			MaxBrakingDeceleration = BrakingDecelerationSprinting;
+		}
+	}
+
+	void ModifyGroundFriction(const UCharacterMovementComponent& MoveComp, float& Friction) const
+	{
+		if (bIsSprinting && MoveComp.IsMovingOnGround())
+		{
+			Friction = GroundFrictionSprinting;
+		}
+	}
+
+	void ModifyBrakingFriction(const UCharacterMovementComponent& MoveComp, float& Friction) const
+	{
+		if (bIsSprinting && MoveComp.IsMovingOnGround())
+		{
+			Friction = MoveComp.bUseSeparateBrakingFriction ? BrakingFrictionSprinting : GroundFrictionSprinting;
+		}
+	}
+
+	void UpdateBeforeMovement(UCharacterMovementComponent& MoveComp, float DeltaSeconds)
+	{
+		// Check for a change in Sprint state. Players toggle Sprint by changing bWantsToSprint.
+		if (bIsSprinting && (!bWantsToSprint || !CanSprintInCurrentState(MoveComp)))
+		{
+			bIsSprinting = false;
+		}
+		else if (!bIsSprinting && bWantsToSprint && CanSprintInCurrentState(MoveComp))
+		{
+			bIsSprinting = true;
+		}
+	}
+
+	void UpdateAfterMovement(UCharacterMovementComponent& MoveComp, float DeltaSeconds)
+	{
+		// UnSprint if no longer allowed to be Sprinting
+		if (bIsSprinting && !CanSprintInCurrentState(MoveComp))
+		{
+			bIsSprinting = false;
+		}
+	}
+};
+
+/**
+ * Strafe as a composable feature, the equivalent of UStrafeMovement
+ */
+USTRUCT()
+struct PREDICTEDMOVEMENT_API FStrafeFeature : public FPredictedMovementFeature
+{
+	GENERATED_BODY()
+
+	FStrafeFeature()
+		: MaxAccelerationStrafing(1024.f)
+		, MaxWalkSpeedStrafing(400.f)
+		, BrakingDecelerationStrafing(512.f)
+		, GroundFrictionStrafing(12.f)
+		, BrakingFrictionStrafing(4.f)
+		, bWantsToStrafe(false)
+		, bIsStrafing(false)
+	{}
+
+	static constexpr int32 NumInputBits = 1;
+	static constexpr int32 NumStateBits = 1;
+
+	/** Max Acceleration (rate of change of velocity) */
+	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float MaxAccelerationStrafing;
+
+	/** The maximum ground speed when Strafing. */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
+	float MaxWalkSpeedStrafing;
+
+	/** Deceleration when walking and not applying acceleration. @see UCharacterMovementComponent::BrakingDecelerationWalking */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float BrakingDecelerationStrafing;
+
+	/** Setting that affects movement control. @see UCharacterMovementComponent::GroundFriction */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float GroundFrictionStrafing;
+
+	/** Friction (drag) coefficient applied when braking. @see UCharacterMovementComponent::BrakingFriction */
+	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere, meta=(ClampMin="0", UIMin="0"))
+	float BrakingFrictionStrafing;
+
+	/** If true, try to Strafe (or keep Strafing) on next update. If false, try to stop Strafing on next update. */
+	uint8 bWantsToStrafe:1;
+
+	/** True while Strafing, replicated to simulated proxies through the packed state bits */
+	uint8 bIsStrafing:1;
+
+	bool IsStrafing() const { return bIsStrafing; }
+
+	/** Returns true if the character is allowed to Strafe in the current state. By default it is allowed when walking or falling. */
+	bool CanStrafeInCurrentState(const UCharacterMovementComponent& MoveComp) const
+	{
+		return MoveComp.UpdatedComponent && !MoveComp.UpdatedComponent->IsSimulatingPhysics() &&
+			(MoveComp.IsFalling() || MoveComp.IsMovingOnGround());
+	}
+
+	uint32 GetInputBits() const { return bWantsToStrafe ? 1 : 0; }
+	void SetInputBits(uint32 Bits) { bWantsToStrafe = (Bits & 1) != 0; }
+
+	uint32 GetStateBits() const { return bIsStrafing ? 1 : 0; }
+	void SetSimulatedStateBits(UCharacterMovementComponent& MoveComp, uint32 Bits)
+	{
+		bIsStrafing = (Bits & 1) != 0;
+		bWantsToStrafe = bIsStrafing;
+	}
+
+	void ModifyMaxSpeed(const UCharacterMovementComponent& MoveComp, float& MaxSpeed) const
+	{
+		if (bIsStrafing)
+		{
+			MaxSpeed = MaxWalkSpeedStrafing;
+		}
+	}
+
+	void ModifyMaxAcceleration(const UCharacterMovementComponent& MoveComp, float& MaxAcceleration) const
+	{
+		if (bIsStrafing && MoveComp.IsMovingOnGround())
+		{
+			MaxAcceleration = MaxAccelerationStrafing;
+		}
+	}
+
+	void ModifyMaxBrakingDeceleration(const UCharacterMovementComponent& MoveComp, float& MaxBrakingDeceleration) const
+	{
+		if (bIsStrafing && MoveComp.IsMovingOnGround())
+		{
+			MaxBrakingDeceleration = BrakingDecelerationStrafing;
+		}
+	}
+
+	void ModifyGroundFriction(const UCharacterMovementComponent& MoveComp, float& Friction) const
+	{
+		if (bIsStrafing && MoveComp.IsMovingOnGround())
+		{
+			Friction = GroundFrictionStrafing;
+		}
+	}
+
+	void ModifyBrakingFriction(const UCharacterMovementComponent& MoveComp, float& Friction) const
+	{
+		if (bIsStrafing && MoveComp.IsMovingOnGround())
+		{
+			Friction = MoveComp.bUseSeparateBrakingFriction ? BrakingFrictionStrafing : GroundFrictionStrafing;
+		}
+	}
+
+	void UpdateBeforeMovement(UCharacterMovementComponent& MoveComp, float DeltaSeconds)
+	{
+		// Check for a change in Strafe state. Players toggle Strafe by changing bWantsToStrafe.
+		if (bIsStrafing && (!bWantsToStrafe || !CanStrafeInCurrentState(MoveComp)))
+		{
+			bIsStrafing = false;
+		}
+		else if (!bIsStrafing && bWantsToStrafe && CanStrafeInCurrentState(MoveComp))
+		{
+			bIsStrafing = true;
+		}
+	}
+
+	void UpdateAfterMovement(UCharacterMovementComponent& MoveComp, float DeltaSeconds)
+	{
+		// UnStrafe if no longer allowed to be Strafing
+		if (bIsStrafing && !CanStrafeInCurrentState(MoveComp))
+		{
+			bIsStrafing = false;
+		}
+	}
+};
+
+/**
+ * Stamina as a composable feature, the equivalent of UStaminaMovement
+ * Drains while bDrainingStamina is set by the composed component, and regenerates otherwise
+ */
+USTRUCT()
+struct PREDICTEDMOVEMENT_API FStaminaFeature : public FPredictedMovementFeature
+{
+	GENERATED_BODY()
+
+	FStaminaFeature()
+		: NetworkStaminaCorrectionThreshold(2.f)
+		, MaxStamina(100.f)
+		, StaminaDrainRate(20.f)
+		, StaminaRegenRate(10.f)
+		, bDrainingStamina(false)
+		, Stamina(100.f)
+		, bStaminaDrained(false)
+	{}
+
+	/** Maximum stamina difference that is allowed between client and server before a correction occurs. */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, meta=(ClampMin="0.0", UIMin="0.0"))
+	float NetworkStaminaCorrectionThreshold;
+
+	/** Stamina is initialized to this value, you will need to handle any changes to MaxStamina, it is not predicted */
+	UPROPERTY(Category="Character Movement: Stamina", EditAnywhere, meta=(ClampMin="0.0", UIMin="0.0"))
+	float MaxStamina;
+
+	/** Stamina consumed per second while bDrainingStamina is set */
+	UPROPERTY(Category="Character Movement: Stamina", EditAnywhere, meta=(ClampMin="0.0", UIMin="0.0"))
+	float StaminaDrainRate;
+
+	/** Stamina regenerated per second while bDrainingStamina is not set, 0 disables regeneration */
+	UPROPERTY(Category="Character Movement: Stamina", EditAnywhere, meta=(ClampMin="0.0", UIMin="0.0"))
+	float StaminaRegenRate;
+
+	/**
+	 * Set by the composed component while stamina is being consumed, e.g. while Sprinting in effect
+	 * Must be derived from predicted state before every update, it is not saved or sent
+	 */
+	bool bDrainingStamina;
+
+protected:
+	float Stamina;
+	bool bStaminaDrained;
+
+public:
+	struct FSavedState
+	{
+		bool bStaminaDrained = false;
+		float StartStamina = 0.f;
+		float EndStamina = 0.f;
+
+		void Clear()
+		{
+			bStaminaDrained = false;
+			StartStamina = 0.f;
+			EndStamina = 0.f;
+		}
+
+		void SetInitialPosition(const FStaminaFeature& Feature)
+		{
+			bStaminaDrained = Feature.IsStaminaDrained();
+			StartStamina = Feature.GetStamina();
+		}
+
+		void PostUpdate(const FStaminaFeature& Feature, bool& bForceNoCombine)
+		{
+			// When considering whether to delay or combine moves, we need to compare the move at the start and the end
+			EndStamina = Feature.GetStamina();
+			if (bStaminaDrained != Feature.IsStaminaDrained())
+			{
+				bForceNoCombine = true;
+			}
+		}
+
+		void CombineWith(FStaminaFeature& Feature) const
+		{
+			Feature.SetStamina(StartStamina);
+			Feature.SetStaminaDrained(bStaminaDrained);
+		}
+
+		bool CanCombineWith(const FSavedState& NewMove) const
+		{
+			return bStaminaDrained == NewMove.bStaminaDrained;
+		}
+	};
+
+	struct FMoveData
+	{
+		float Stamina = 0.f;
+
+		void Fill(const FSavedState& SavedState) { Stamina = SavedState.EndStamina; }
+		void Serialize(FArchive& Ar) { SerializeOptionalValue<float>(Ar.IsSaving(), Ar, Stamina, 0.f); }
+	};
+
+	struct FResponseData
+	{
+		float Stamina = 0.f;
+		bool bStaminaDrained = false;
+
+		void Fill(const FStaminaFeature& Feature)
+		{
+			Stamina = Feature.GetStamina();
+			bStaminaDrained = Feature.IsStaminaDrained();
+		}
+
+		void Serialize(FArchive& Ar)
+		{
+			Ar << Stamina;
+			Ar << bStaminaDrained;
+		}
+
+		void Apply(FStaminaFeature& Feature) const
+		{
+			Feature.SetStamina(Stamina);
+			Feature.SetStaminaDrained(bStaminaDrained);
+		}
+	};
+
+	float GetStamina() const { return Stamina; }
+	float GetMaxStamina() const { return MaxStamina; }
+	bool IsStaminaDrained() const { return bStaminaDrained; }
+
+	void SetStamina(float NewStamina);
+	void SetMaxStamina(float NewMaxStamina);
+	void SetStaminaDrained(bool bNewValue) { bStaminaDrained = bNewValue; }
+
+	void Initialize(UCharacterMovementComponent& MoveComp)
+	{
+		Stamina = MaxStamina;
+		bStaminaDrained = false;
+	}
+
+	/** Drain or regenerate within the physics substeps, so the result matches however the moves are split */
+	void CalcVelocity(UCharacterMovementComponent& MoveComp, float DeltaTime)
+	{
+		if (bDrainingStamina)
+		{
+			SetStamina(Stamina - StaminaDrainRate * DeltaTime);
+		}
+		else if (StaminaRegenRate > 0.f && Stamina < MaxStamina)
+		{
+			SetStamina(Stamina + StaminaRegenRate * DeltaTime);
+		}
+	}
+
+	bool ServerCheckClientError(const FMoveData& MoveData) const
+	{
+		// Desyncs can happen if we set the Stamina directly in Gameplay code (ie: GAS)
+		return FMath::Abs(MoveData.Stamina - Stamina) > NetworkStaminaCorrectionThreshold;
+	}
+};
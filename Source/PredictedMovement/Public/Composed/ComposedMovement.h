@@ -0,0 +1,111 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Composed/ComposedFeatures.h"
+#include "System/PredictedMovementVersioning.h"
+#include "ComposedMovement.generated.h"
+
+class AComposedCharacter;
+
+/**
+ * A single movement component composed from Sprint, Strafe and Stamina features
+ *
+ * Unlike inheriting USprintMovement ➜ UStrafeMovement ➜ UStaminaMovement, there is a single saved move, network move
+ * data and response container, the input bits of every feature are packed into a single field, and each getter is a
+ * single virtual call with every feature folded in by the compiler.
+ *
+ * Sprinting drains stamina while it is in effect, and is unavailable while stamina is drained.
+ *
+ * The feature list is the template parameter list of FFeatureSet, and everything else is shared by TComposedMovement.
+ * To compose a different list, declare FFeatureSet, a property for each feature and GetFeatures() in your own
+ * component, and forward to TComposedMovement as this class does.
+ */
+UCLASS()
+class PREDICTEDMOVEMENT_API UComposedMovement : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Later features take precedence, Sprint overrides Strafe */
+	using FFeatureSet = TPredictedFeatureSet<FStaminaFeature, FStrafeFeature, FSprintFeature>;
+	using FComposition = TComposedMovement<UComposedMovement>;
+
+private:
+	/** Character movement component belongs to */
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<AComposedCharacter> ComposedCharacterOwner;
+
+public:
+	UPROPERTY(Category="Character Movement: Stamina", EditAnywhere)
+	FStaminaFeature Stamina;
+
+	UPROPERTY(Category="Character Movement: Strafe", EditAnywhere)
+	FStrafeFeature Strafe;
+
+	UPROPERTY(Category="Character Movement: Sprint", EditAnywhere)
+	FSprintFeature Sprint;
+
+protected:
+	/** Packed state bits of every feature as of the last update */
+	uint32 FeatureStateBits;
+
+public:
+	UComposedMovement(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	FFeatureSet::FRefs GetFeatures() { return FFeatureSet::FRefs(Stamina, Strafe, Sprint); }
+	FFeatureSet::FConstRefs GetFeatures() const { return FFeatureSet::FConstRefs(Stamina, Strafe, Sprint); }
+
+	virtual bool HasValidData() const override;
+	virtual void PostLoad() override;
+	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
+
+public:
+	virtual float GetMaxAcceleration() const override;
+	virtual float GetMaxSpeed() const override;
+	virtual float GetMaxBrakingDeceleration() const override;
+
+	virtual void CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration) override;
+	virtual void ApplyVelocityBraking(float DeltaTime, float Friction, float BrakingDeceleration) override;
+
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	virtual void UpdateCharacterStateAfterMovement(float DeltaSeconds) override;
+
+	/** Apply state bits replicated to a simulated proxy */
+	void ApplySimulatedFeatureState(uint32 NewStateBits);
+
+protected:
+	/** Compare state bits against the last update, push them to the owner and notify it if they changed */
+	void UpdateFeatureState();
+
+	/** Derive the state features share from each other, before they are updated */
+	void UpdateFeatureLinks();
+
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+private:
+	TComposedMoveResponseDataContainer<UComposedMovement, FFeatureSet> ComposedMoveResponseDataContainer;
+
+	TComposedNetworkMoveDataContainer<UComposedMovement, FFeatureSet> ComposedMoveDataContainer;
+
+public:
+	virtual void OnClientCorrectionReceived(class FNetworkPredictionData_Client_Character& ClientData, float TimeStamp,
+		FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase,
+		bool bBaseRelativePosition, uint8 ServerMovementMode
+#if UE_5_03_OR_LATER
+		, FVector ServerGravityDirection) override;
+#else
+		) override;
+#endif
+
+	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel,
+		const FVector& ClientWorldLocation, const FVector& RelativeClientLocation,
+		UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+
+	/** Get prediction data for a client game. Should not be used if not running as a client. Allocates the data on demand and can be overridden to allocate a custom override if desired. Result must be a FNetworkPredictionData_Client_Character. */
+	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+};
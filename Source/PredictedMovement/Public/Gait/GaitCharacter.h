@@ -0,0 +1,64 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Character.h"
+#include "Gait/GaitMovement.h"
+#include "GaitCharacter.generated.h"
+
+UCLASS()
+class PREDICTEDMOVEMENT_API AGaitCharacter : public ACharacter
+{
+	GENERATED_BODY()
+
+private:
+	/** Movement component used for movement logic in various movement modes (walking, falling, etc), containing relevant settings and functions to control movement. */
+	UPROPERTY(Category=Character, VisibleAnywhere, BlueprintReadOnly, meta=(AllowPrivateAccess = "true"))
+	TObjectPtr<UGaitMovement> GaitMovement;
+
+	friend class FSavedMove_Character_Gait;
+protected:
+	FORCEINLINE UGaitMovement* GetGaitCharacterMovement() const { return GaitMovement; }
+
+protected:
+	/** Set by character movement to specify the current Gait of this Character. */
+	UPROPERTY(BlueprintReadOnly, replicatedUsing=OnRep_Gait, Category=Character)
+	EPredictedGait Gait;
+
+public:
+	AGaitCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+public:
+	void SetGait(EPredictedGait NewGait);
+
+	/** @return The current Gait of this character */
+	UFUNCTION(BlueprintPure, Category=Character)
+	EPredictedGait GetGait() const { return Gait; }
+
+	/** Handle Gait replicated from server */
+	UFUNCTION()
+	virtual void OnRep_Gait(EPredictedGait PrevGait);
+
+	/**
+	 * Request the character to change Gait. The request is processed on the next update of the CharacterMovementComponent.
+	 * @see OnGaitChanged
+	 * @see GetGait
+	 * @see CharacterMovement->WantsGait
+	 */
+	UFUNCTION(BlueprintCallable, Category=Character)
+	virtual void RequestGait(EPredictedGait NewGait);
+
+	/** @return The Gait the character has requested, which may not be allowed in the current state */
+	UFUNCTION(BlueprintPure, Category=Character)
+	EPredictedGait GetWantsGait() const;
+
+	/** Called when Character changes Gait. Called on non-owned Characters through Gait replication. */
+	virtual void OnGaitChanged(EPredictedGait PrevGait, EPredictedGait NewGait);
+
+	/** Event when Character changes Gait. */
+	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName="On Gait Changed"))
+	void K2_OnGaitChanged(EPredictedGait PrevGait, EPredictedGait NewGait);
+};
@@ -0,0 +1,195 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "System/PredictedInputFlags.h"
+#include "GaitMovement.generated.h"
+
+class AGaitCharacter;
+
+/**
+ * A single predicted gait, rather than a boolean shell per gait
+ * Gaits are mutually exclusive and ordered from slowest to fastest
+ */
+UENUM(BlueprintType)
+enum class EPredictedGait : uint8
+{
+	Stroll,
+	Walk,
+	Run,
+	Sprint,
+	MAX			UMETA(Hidden)
+};
+
+/** Gait is sent client ➜ server in this many bits */
+static constexpr int32 PredictedGaitNumBits = 2;
+static_assert(static_cast<int32>(EPredictedGait::MAX) <= (1 << PredictedGaitNumBits), "EPredictedGait does not fit within PredictedGaitNumBits");
+
+/** Movement properties for a single gait */
+USTRUCT(BlueprintType)
+struct PREDICTEDMOVEMENT_API FGaitParams
+{
+	GENERATED_BODY()
+
+	FGaitParams(float InMaxWalkSpeed = 600.f, float InMaxAcceleration = 2048.f, float InBrakingDeceleration = 2048.f,
+		float InGroundFriction = 8.f, float InBrakingFriction = 0.f)
+		: MaxWalkSpeed(InMaxWalkSpeed)
+		, MaxAcceleration(InMaxAcceleration)
+		, BrakingDeceleration(InBrakingDeceleration)
+		, GroundFriction(InGroundFriction)
+		, BrakingFriction(InBrakingFriction)
+	{}
+
+	/** The maximum ground speed for this gait. */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", ForceUnits="cm/s"))
+	float MaxWalkSpeed;
+
+	/** Max Acceleration (rate of change of velocity) */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+	float MaxAcceleration;
+
+	/**
+	 * Deceleration when walking and not applying acceleration. This is a constant opposing force that directly lowers velocity by a constant value.
+	 * @see GroundFriction, MaxAcceleration
+	 */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+	float BrakingDeceleration;
+
+	/**
+	 * Setting that affects movement control. Higher values allow faster changes in direction.
+	 * @see UCharacterMovementComponent::GroundFriction
+	 */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+	float GroundFriction;
+
+	/**
+	 * Friction (drag) coefficient applied when braking
+	 * @note Only used if bUseSeparateBrakingFriction setting is true, otherwise GroundFriction is used.
+	 * @see UCharacterMovementComponent::BrakingFriction
+	 */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0"))
+	float BrakingFriction;
+};
+
+/**
+ * Gait is a predicted shell for a multi-level gait (Stroll, Walk, Run, Sprint), built on the USprintMovement pattern
+ *
+ * The desired gait is sent in PredictedGaitNumBits of FPredictedInputFlags rather than a compressed flag per gait,
+ * and the current gait is replicated to simulated proxies as a single byte. Contradictory states such as
+ * strolling and sprinting at once are not representable.
+ *
+ * Gait params are only applied while moving on the ground and not crouching, override GetGaitParams() or the getters
+ * to change this.
+ */
+UCLASS()
+class PREDICTEDMOVEMENT_API UGaitMovement : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+private:
+	/** Character movement component belongs to */
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<AGaitCharacter> GaitCharacterOwner;
+
+public:
+	/** Movement properties for each gait, indexed by EPredictedGait, use Get/SetParamsForGait() from Blueprint */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, meta=(ArraySizeEnum="/Script/PredictedMovement.EPredictedGait"))
+	FGaitParams GaitParams[(uint8)EPredictedGait::MAX];
+
+public:
+	/** The gait to change to (or keep) on next update, if allowed by CanGaitInCurrentState() */
+	UPROPERTY(Category="Character Movement (General Settings)", VisibleInstanceOnly, BlueprintReadOnly)
+	EPredictedGait WantsGait;
+
+public:
+	UGaitMovement(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual bool HasValidData() const override;
+	virtual void PostLoad() override;
+	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
+
+public:
+	/** @return Input bits used to send WantsGait client ➜ server */
+	static const FPredictedInputFlag& GetGaitInputFlag();
+
+	/** @return Current gait */
+	EPredictedGait GetGait() const;
+
+	/** @return Params for the current gait if they apply in the current state, otherwise nullptr */
+	virtual const FGaitParams* GetGaitParams() const;
+
+	/** @return Movement properties for the specified gait */
+	UFUNCTION(BlueprintPure, Category="Character Movement: Walking")
+	FGaitParams GetParamsForGait(EPredictedGait Gait) const;
+
+	/** Change the movement properties for the specified gait, this must happen on both client and server */
+	UFUNCTION(BlueprintCallable, Category="Character Movement: Walking")
+	void SetParamsForGait(EPredictedGait Gait, const FGaitParams& Params);
+
+	virtual float GetMaxAcceleration() const override;
+	virtual float GetMaxSpeed() const override;
+	virtual float GetMaxBrakingDeceleration() const override;
+
+	virtual void CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration) override;
+	virtual void ApplyVelocityBraking(float DeltaTime, float Friction, float BrakingDeceleration) override;
+
+public:
+	/**
+	 * Change to the new gait, or the fastest allowed gait below it, and call CharacterOwner->OnGaitChanged() if it changed
+	 * In general you should set WantsGait instead to have the gait persist during movement, or just use the gait
+	 * functions on the owning Character.
+	 * @param	NewGait				Gait to change to
+	 * @param	bClientSimulation	true when called when Gait is replicated to non owned clients.
+	 */
+	virtual void SetGait(EPredictedGait NewGait, bool bClientSimulation = false);
+
+	/** Returns true if the character is allowed to use this gait in the current state. By default gaits above Walk are only allowed when walking or falling. */
+	virtual bool CanGaitInCurrentState(EPredictedGait InGait) const;
+
+	/** @return The fastest gait, up to and including InGait, that is allowed in the current state */
+	EPredictedGait GetAllowedGait(EPredictedGait InGait) const;
+
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+	virtual void UpdateCharacterStateAfterMovement(float DeltaSeconds) override;
+
+protected:
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+private:
+	FPredictedInputNetworkMoveDataContainer GaitMoveDataContainer;
+
+public:
+	/** Get prediction data for a client game. Should not be used if not running as a client. Allocates the data on demand and can be overridden to allocate a custom override if desired. Result must be a FNetworkPredictionData_Client_Character. */
+	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+};
+
+class PREDICTEDMOVEMENT_API FSavedMove_Character_Gait : public FSavedMove_Character_PredictedInput
+{
+	using Super = FSavedMove_Character_PredictedInput;
+
+public:
+	virtual ~FSavedMove_Character_Gait() override
+	{}
+
+	/** Called to set up this saved move (when initially created) to make a predictive correction. */
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, class FNetworkPredictionData_Client_Character & ClientData) override;
+
+	/** Called before ClientUpdatePosition uses this SavedMove to make a predictive correction	 */
+	virtual void PrepMoveFor(ACharacter* C) override;
+};
+
+class PREDICTEDMOVEMENT_API FNetworkPredictionData_Client_Character_Gait : public FNetworkPredictionData_Client_Character
+{
+	using Super = FNetworkPredictionData_Client_Character;
+
+public:
+	FNetworkPredictionData_Client_Character_Gait(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+	{}
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
@@ -27,10 +27,44 @@ protected:
 protected:
 	FORCEINLINE UModifierMovement* GetModifierCharacterMovement() const { return ModifierMovement; }
 
+public:
+	/**
+	 * Changes to simulated modifier levels are held for this long before replicating, so that a level which changes
+	 * and changes back within the window, e.g. due to stack eviction, is never sent to simulated proxies
+	 * 0 to replicate on the same frame
+	 */
+	UPROPERTY(Category="Character|Modifiers", EditDefaultsOnly, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", UIMax="0.5", ForceUnits="s"))
+	float SimulatedModifierCoalesceWindow = 0.f;
+
+	/** Minimum time a level is replicated for before simulated proxies receive the next level of the same modifier */
+	UPROPERTY(Category="Character|Modifiers", EditDefaultsOnly, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", UIMax="1", ForceUnits="s"))
+	float SimulatedModifierMinHoldTime = 0.f;
+
+	/**
+	 * How simulated proxies that aren't significant handle modifier events (OnModifierChanged, Added and Removed)
+	 * Movement always uses the latest levels, only the events are deferred or dropped
+	 */
+	UPROPERTY(Category="Character|Modifiers", EditDefaultsOnly, BlueprintReadWrite)
+	EModifierProxyLOD ProxyModifierLOD = EModifierProxyLOD::Disabled;
+
+	/** Simulated proxies further than this from the local view are not significant, 0 to ignore distance */
+	UPROPERTY(Category="Character|Modifiers", EditDefaultsOnly, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", ForceUnits="cm", EditCondition="ProxyModifierLOD!=EModifierProxyLOD::Disabled", EditConditionHides))
+	float ProxyModifierLODDistance = 5000.f;
+
+	/** Simulated proxies that haven't been rendered recently are not significant */
+	UPROPERTY(Category="Character|Modifiers", EditDefaultsOnly, BlueprintReadWrite, meta=(EditCondition="ProxyModifierLOD!=EModifierProxyLOD::Disabled", EditConditionHides))
+	bool bProxyModifierLODRequireRendered = true;
+
+	/** How often simulated proxies evaluate their significance */
+	UPROPERTY(Category="Character|Modifiers", EditDefaultsOnly, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", UIMax="1", ForceUnits="s", EditCondition="ProxyModifierLOD!=EModifierProxyLOD::Disabled", EditConditionHides))
+	float ProxyModifierLODInterval = 0.25f;
+
 public:
 	AModifierCharacter(const FObjectInitializer& FObjectInitializer);
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	virtual void PawnClientRestart() override;
 	
 public:
 	template<typename T>
@@ -53,6 +87,65 @@ public:
 	virtual void OnModifierAdded(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel, const FGameplayTag& PrevModifierLevel);
 	virtual void OnModifierRemoved(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel, const FGameplayTag& PrevModifierLevel);
 
+	/** Replicate the modifier level to simulated proxies, without dispatching any events. Server only. */
+	void SetSimulatedModifierLevel(const FGameplayTag& ModifierType, uint8 Level);
+
+protected:
+	/** Set by character movement to specify this Character's Boost, Snare and SlowFall levels */
+	UPROPERTY(ReplicatedUsing=OnRep_SimulatedModifierLevels)
+	FSimulatedModifierLevels SimulatedModifierLevels;
+
+	/** Apply modifier levels replicated from server, and dispatch events for those that changed, subject to ProxyModifierLOD */
+	UFUNCTION()
+	virtual void OnRep_SimulatedModifierLevels();
+
+	/** Levels that modifier events have been dispatched for, behind SimulatedModifierLevels while events are deferred */
+	FSimulatedModifierLevels NotifiedModifierLevels;
+
+	/** Whether this proxy was significant when last evaluated, see ProxyModifierLOD */
+	bool bProxyModifierSignificant = true;
+
+	/** World time to evaluate significance next */
+	double NextProxyModifierLODTime = 0.0;
+
+	/** Dispatch events for every level that differs from NotifiedModifierLevels, in one step */
+	void DispatchSimulatedModifierEvents();
+
+	/** Levels waiting for the coalesce window or hold time before they are copied to SimulatedModifierLevels */
+	FSimulatedModifierLevels PendingSimulatedModifierLevels;
+
+	/** World time each level of SimulatedModifierLevels last changed */
+	double SimulatedModifierChangeTimes[(uint8)ESimulatedModifier::MAX] = {};
+
+	/** World time the first pending change was made, negative if nothing is pending */
+	double SimulatedModifierWindowStart = -1.0;
+
+	/** Number of changes that were never replicated because they were superseded within the window */
+	int32 NumSuppressedSimulatedModifierUpdates = 0;
+
+public:
+	/**
+	 * Replicate pending modifier levels once the coalesce window and hold times have elapsed
+	 * Server only, called by character movement each tick
+	 */
+	void FlushSimulatedModifierLevels();
+
+	/** @return Number of changes that were never replicated because they were superseded within the window */
+	int32 GetNumSuppressedSimulatedModifierUpdates() const { return NumSuppressedSimulatedModifierUpdates; }
+
+	/**
+	 * Re-evaluate significance every ProxyModifierLODInterval, dispatching deferred events once significant again
+	 * Simulated proxies only, called by character movement each tick
+	 */
+	void UpdateProxyModifierLOD();
+
+	/**
+	 * @return True if modifier events should be dispatched for this simulated proxy
+	 * Uses ProxyModifierLODDistance and bProxyModifierLODRequireRendered, override to use the significance manager instead
+	 */
+	virtual bool IsModifierProxySignificant() const;
+
+
 	UFUNCTION(BlueprintImplementableEvent, Category=Character, meta=(DisplayName="On Modifier Added"))
 	void K2_OnModifierAdded(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel, const FGameplayTag& PrevModifierLevel);
 
@@ -70,35 +163,50 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Character Movement (Networking)")
 	virtual void GrantClientAuthority(FGameplayTag ClientAuthSource, float OverrideDuration = -1.f);
+
+public:
+	/** @return True if the handle was returned by a modifier that was added, it may since have been removed */
+	UFUNCTION(BlueprintPure, Category=Character)
+	static bool IsModifierHandleValid(const FModifierHandle& Handle) { return Handle.IsValid(); }
 	
 public:
 	/* Boost Implementation */
 	
-	/** Set by character movement to specify that this Character's Boost level. */
-	UPROPERTY(ReplicatedUsing=OnRep_SimulatedBoost)
-	uint8 SimulatedBoost = NO_MODIFIER;
-
-	/** Handle Boost replicated from server */
-	UFUNCTION()
-	virtual void OnRep_SimulatedBoost(uint8 PrevLevel);
+	/** Dispatch events for Boost replicated from server via SimulatedModifierLevels, already applied to movement */
+	virtual void OnSimulatedBoostChanged(uint8 PrevLevel);
 
 	/**
 	 * Request the character to start Boost. The request is processed on the next update of the CharacterMovementComponent.
 	 * @param Level The level of the Boost to remove.
 	 * @param NetType How the Boost is applied, either locally predicted, with correction, or server initiated.
+	 * @param Duration If greater than zero, the Boost is removed after this many seconds, predicted by both client and server.
+	 * @return Handle to remove this Boost with UnBoostByHandle(), invalid if the Boost was not added.
 	 */
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.Boost"))
-	virtual bool Boost(FGameplayTag Level, EModifierNetType NetType);
+	virtual FModifierHandle Boost(FGameplayTag Level, EModifierNetType NetType, float Duration = 0.f);
 
 	/**
 	 * Request the character to stop Boost. The request is processed on the next update of the CharacterMovementComponent.
 	 * @param Level The level of the Boost to remove.
 	 * @param NetType How the Boost is applied, either locally predicted, with correction, or server initiated.
-	 * @param bRemoveAll If true, removes all Boosts of the specified level, otherwise only removes the first one found.
+	 * @param bRemoveAll If true, removes all Boosts of the specified level, otherwise only removes the first one found, preferring Boosts without a Duration.
 	 */
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.Boost"))
 	virtual bool UnBoost(FGameplayTag Level, EModifierNetType NetType, bool bRemoveAll=false);
 
+	/**
+	 * Remove the Boost that returned this handle, leaving other Boosts of the same level in place.
+	 * @return True if the Boost was removed, false if it was already removed, or the handle is invalid or not from Boost().
+	 */
+	UFUNCTION(BlueprintCallable, Category=Character)
+	virtual bool UnBoostByHandle(const FModifierHandle& Handle);
+
+	/** Boost() for a level index that has already been resolved, e.g. once for many characters */
+	virtual FModifierHandle BoostByIndex(uint8 LevelIndex, EModifierNetType NetType, float Duration = 0.f);
+
+	/** UnBoost() for a level index that has already been resolved, e.g. once for many characters */
+	virtual bool UnBoostByIndex(uint8 LevelIndex, EModifierNetType NetType, bool bRemoveAll=false);
+
 	/**
 	 * Reset the Boost for the specified NetType, removing all Boosts of that type.
 	 * @return True if any modifiers were removed, false if none were found.
@@ -125,22 +233,19 @@ public:
 public:
 	/* Snare Implementation */
 	
-	/** Set by character movement to specify that this Character's Snare level. */
-	UPROPERTY(ReplicatedUsing=OnRep_SimulatedSnare)
-	uint8 SimulatedSnare = NO_MODIFIER;
-
-	/** Handle Snare replicated from server */
-	UFUNCTION()
-	virtual void OnRep_SimulatedSnare(uint8 PrevLevel);
+	/** Dispatch events for Snare replicated from server via SimulatedModifierLevels, already applied to movement */
+	virtual void OnSimulatedSnareChanged(uint8 PrevLevel);
 
 	/**
 	 * Request the character to start Modified. The request is processed on the next update of the CharacterMovementComponent.
 	 * @see OnStartModifier
 	 * @see IsModified
 	 * @see CharacterMovement->WantsToModifier
+	 * @param Duration If greater than zero, the Snare is removed after this many seconds, predicted by both client and server.
+	 * @return Handle to remove this Snare with UnSnareByHandle(), invalid if the Snare was not added.
 	 */
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.Snare"))
-	virtual bool Snare(FGameplayTag Level);
+	virtual FModifierHandle Snare(FGameplayTag Level, float Duration = 0.f);
 
 	/**
 	 * Request the character to stop Modified. The request is processed on the next update of the CharacterMovementComponent.
@@ -151,6 +256,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.Snare"))
 	virtual bool UnSnare(FGameplayTag Level, bool bRemoveAll=false);
 
+	/**
+	 * Remove the Snare that returned this handle, leaving other Snares of the same level in place.
+	 * @return True if the Snare was removed, false if it was already removed, or the handle is invalid or not from Snare().
+	 */
+	UFUNCTION(BlueprintCallable, Category=Character)
+	virtual bool UnSnareByHandle(const FModifierHandle& Handle);
+
+	/** Snare() for a level index that has already been resolved, e.g. once for many characters */
+	virtual FModifierHandle SnareByIndex(uint8 LevelIndex, float Duration = 0.f);
+
+	/** UnSnare() for a level index that has already been resolved, e.g. once for many characters */
+	virtual bool UnSnareByIndex(uint8 LevelIndex, bool bRemoveAll=false);
+
 	/**
 	 * Reset the Snare for the specified NetType, removing all Snares of that type.
 	 * @return True if any modifiers were removed, false if none were found.
@@ -177,29 +295,33 @@ public:
 public:
 	/* SlowFall Implementation */
 	
-	/** Set by character movement to specify that this Character's SlowFall level. */
-	UPROPERTY(ReplicatedUsing=OnRep_SimulatedSlowFall)
-	uint8 SimulatedSlowFall = NO_MODIFIER;
-
-	/** Handle SlowFall replicated from server */
-	UFUNCTION()
-	virtual void OnRep_SimulatedSlowFall(uint8 PrevLevel);
+	/** Dispatch events for SlowFall replicated from server via SimulatedModifierLevels, already applied to movement */
+	virtual void OnSimulatedSlowFallChanged(uint8 PrevLevel);
 
 	/**
 	 * Request the character to start SlowFall. The request is processed on the next update of the CharacterMovementComponent.
 	 * @param Level The level of the SlowFall to remove.
+	 * @param Duration If greater than zero, the SlowFall is removed after this many seconds, predicted by both client and server.
+	 * @return Handle to remove this SlowFall with UnSlowFallByHandle(), invalid if the SlowFall was not added.
 	 */
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.SlowFall"))
-	virtual bool SlowFall(FGameplayTag Level);
+	virtual FModifierHandle SlowFall(FGameplayTag Level, float Duration = 0.f);
 
 	/**
 	 * Request the character to stop SlowFall. The request is processed on the next update of the CharacterMovementComponent.
 	 * @param Level The level of the SlowFall to remove.
-	 * @param bRemoveAll If true, removes all SlowFalls of the specified level, otherwise only removes the first one found.
+	 * @param bRemoveAll If true, removes all SlowFalls of the specified level, otherwise only removes the first one found, preferring SlowFalls without a Duration.
 	 */
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.SlowFall"))
 	virtual bool UnSlowFall(FGameplayTag Level, bool bRemoveAll=false);
 
+	/**
+	 * Remove the SlowFall that returned this handle, leaving other SlowFalls of the same level in place.
+	 * @return True if the SlowFall was removed, false if it was already removed, or the handle is invalid or not from SlowFall().
+	 */
+	UFUNCTION(BlueprintCallable, Category=Character)
+	virtual bool UnSlowFallByHandle(const FModifierHandle& Handle);
+
 	/**
 	 * Reset the SlowFall for the specified NetType, removing all SlowFalls of that type.
 	 * @return True if any modifiers were removed, false if none were found.
@@ -0,0 +1,118 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "ModifierTypes.h"
+#include "Engine/DataAsset.h"
+#include "ModifierDefinition.generated.h"
+
+/**
+ * Modifier params compiled into flat tables indexed by level, so lookups don't search a TMap
+ * Immutable once built, so a single instance can be shared by every UModifierMovement that uses it
+ */
+struct PREDICTEDMOVEMENT_API FModifierTables
+{
+	/** Levels in natural tag order, the index is sent over the network */
+	TArray<FGameplayTag> BoostLevels;
+	TArray<FGameplayTag> SnareLevels;
+	TArray<FGameplayTag> SlowFallLevels;
+
+	/** Params for each level, parallel to the levels */
+	TArray<FMovementModifierParams> BoostParams;
+	TArray<FMovementModifierParams> SnareParams;
+	TArray<FFallingModifierParams> SlowFallParams;
+
+	TMap<FGameplayTag, FClientAuthParams> ClientAuthParams;
+
+	/** Checksum of the levels, which must match between client and server */
+	uint32 Checksum = 0;
+
+	/** Checksum of the levels and params, identical for identical content, so client and server can agree on it */
+	uint32 Version = 0;
+
+	/** Compile the tables from the modifier maps, baking any SlowFall gravity curves */
+	static TSharedRef<FModifierTables> Build(const TMap<FGameplayTag, FMovementModifierParams>& Boost,
+		const TMap<FGameplayTag, FMovementModifierParams>& Snare, const TMap<FGameplayTag, FFallingModifierParams>& SlowFall,
+		const TMap<FGameplayTag, FClientAuthParams>& ClientAuthParams);
+
+	/**
+	 * Copy Current, taking the params of each of its levels from Source, so that indexes into Current remain valid
+	 * Levels that Source doesn't have, and levels or client auth sources in Keep, retain their current params
+	 */
+	static TSharedRef<FModifierTables> MergeParams(const FModifierTables& Current, const FModifierTables& Source,
+		const TSet<FGameplayTag>& Keep);
+
+	/** Recompute Version from the levels and params */
+	void UpdateVersion();
+
+	/** Shared empty tables, used until tables are built */
+	static TSharedRef<const FModifierTables> GetEmpty();
+
+	const FMovementModifierParams* GetBoostParams(uint8 Level) const { return BoostParams.IsValidIndex(Level) ? &BoostParams[Level] : nullptr; }
+	const FMovementModifierParams* GetSnareParams(uint8 Level) const { return SnareParams.IsValidIndex(Level) ? &SnareParams[Level] : nullptr; }
+	const FFallingModifierParams* GetSlowFallParams(uint8 Level) const { return SlowFallParams.IsValidIndex(Level) ? &SlowFallParams[Level] : nullptr; }
+
+	/** @return Memory used by the tables, including this struct */
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Boost, Snare, SlowFall and client auth definitions shared by every UModifierMovement that references them
+ * Compiled once into FModifierTables, instead of each character owning and searching its own copies
+ */
+UCLASS(BlueprintType)
+class PREDICTEDMOVEMENT_API UModifierDefinition : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Boost params on a per-Boost-level basis */
+	UPROPERTY(Category="Modifiers", EditAnywhere, BlueprintReadOnly, meta=(Categories="Modifier.Boost"))
+	TMap<FGameplayTag, FMovementModifierParams> Boost;
+
+	/** Snare params on a per-Snare-level basis */
+	UPROPERTY(Category="Modifiers", EditAnywhere, BlueprintReadOnly, meta=(Categories="Modifier.Snare"))
+	TMap<FGameplayTag, FMovementModifierParams> Snare;
+
+	/** SlowFall params on a per-SlowFall-level basis */
+	UPROPERTY(Category="Modifiers", EditAnywhere, BlueprintReadOnly, meta=(Categories="Modifier.SlowFall"))
+	TMap<FGameplayTag, FFallingModifierParams> SlowFall;
+
+	/** Client auth parameters mapped to a source gameplay tag */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly)
+	TMap<FGameplayTag, FClientAuthParams> ClientAuthParams;
+
+protected:
+	/** Compiled from the maps above, shared by every UModifierMovement */
+	mutable TSharedPtr<const FModifierTables> Tables;
+
+public:
+	/** Broadcast when Compile() produces tables with a different version, so users can swap to them */
+	FSimpleMulticastDelegate OnTablesChanged;
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** @return Compiled tables, compiling them if needed */
+	TSharedRef<const FModifierTables> GetTables() const;
+
+	/**
+	 * Compile the tables from the maps, and swap every UModifierMovement using them to the new tables
+	 * Characters holding the previous tables keep them alive until they swap
+	 */
+	void Compile();
+
+	/**
+	 * Set a single param, then compile, for tuning at runtime
+	 * @param Level Boost, Snare or SlowFall level, or client auth source
+	 * @param PropertyName Name of the param, e.g. MaxWalkSpeed
+	 * @param Value Value of the param, as text
+	 * @return False if the level or param wasn't found, or the value couldn't be imported
+	 */
+	bool SetParam(const FGameplayTag& Level, FName PropertyName, const FString& Value);
+};
@@ -10,12 +10,19 @@
 using TModSize = uint8;  // If you want more than 254 modifiers, change this to uint16 or uint32
 using TModifierStack = TArray<TModSize>;
 
+// Timestamp at which each modifier in a TModifierStack expires
+using TModifierExpiry = TArray<float>;
+
+// Expiry of a modifier that lasts until it is removed
+#define NO_MODIFIER_EXPIRY MAX_flt
+
 /**
  * FSavedMove_Character
  */
 struct PREDICTEDMOVEMENT_API FModifierSavedMove
 {
 	TModifierStack WantsModifiers;
+	TModifierExpiry WantsExpiry;
 
 	FModifierSavedMove()
 	{}
@@ -25,21 +32,24 @@ struct PREDICTEDMOVEMENT_API FModifierSavedMove
 	virtual void Clear()
 	{
 		WantsModifiers.Empty();
+		WantsExpiry.Empty();
 	}
 
-	void SetMoveFor(const TModifierStack& Modifiers)
+	void SetMoveFor(const TModifierStack& Modifiers, const TModifierExpiry& Expiry)
 	{
 		WantsModifiers = Modifiers;
+		WantsExpiry = Expiry;
 	}
 
-	bool CanCombineWith(const TModifierStack& Modifiers) const
+	bool CanCombineWith(const TModifierStack& Modifiers, const TModifierExpiry& Expiry) const
 	{
-		return WantsModifiers == Modifiers;
+		return WantsModifiers == Modifiers && WantsExpiry == Expiry;
 	}
 
-	void SetInitialPosition(const TModifierStack& Modifiers)
+	void SetInitialPosition(const TModifierStack& Modifiers, const TModifierExpiry& Expiry)
 	{
 		WantsModifiers = Modifiers;
+		WantsExpiry = Expiry;
 	}
 
 	bool IsImportantMove(const TModifierStack& Modifiers) const
@@ -100,11 +110,15 @@ struct PREDICTEDMOVEMENT_API FModifierSavedMove_ServerInitiated
 struct PREDICTEDMOVEMENT_API FModifierMoveResponse
 {
 	TModifierStack Modifiers;
+	TModifierExpiry Expiry;
 
-	void ServerFillResponseData(const TModifierStack& InModifiers)
+	void ServerFillResponseData(const TModifierStack& InModifiers, const TModifierExpiry& InExpiry)
 	{
 		Modifiers = InModifiers;
+		Expiry = InExpiry;
 	}
+
+	bool Serialize(FArchive& Ar, const FString& ErrorName);
 };
 
 /**
@@ -117,10 +131,12 @@ struct PREDICTEDMOVEMENT_API FModifierMoveData_LocalPredicted
 	{}
 	
 	TModifierStack WantsModifiers;
+	TModifierExpiry WantsExpiry;
 
-	void ClientFillNetworkMoveData(const TModifierStack& InWantsModifiers)
+	void ClientFillNetworkMoveData(const TModifierStack& InWantsModifiers, const TModifierExpiry& InWantsExpiry)
 	{
 		WantsModifiers = InWantsModifiers;
+		WantsExpiry = InWantsExpiry;
 	}
 
 	bool Serialize(FArchive& Ar, const FString& ErrorName, uint8 MaxSerializedModifiers=8);
@@ -137,11 +153,14 @@ struct PREDICTEDMOVEMENT_API FModifierMoveData_WithCorrection
 	{}
 
 	TModifierStack WantsModifiers;
+	TModifierExpiry WantsExpiry;
 	TModifierStack Modifiers;
 
-	void ClientFillNetworkMoveData(const TModifierStack& InWantsModifiers, const TModifierStack& InModifiers)
+	void ClientFillNetworkMoveData(const TModifierStack& InWantsModifiers, const TModifierExpiry& InWantsExpiry,
+		const TModifierStack& InModifiers)
 	{
 		WantsModifiers = InWantsModifiers;
+		WantsExpiry = InWantsExpiry;
 		Modifiers = InModifiers;
 	}
 
@@ -175,43 +194,63 @@ struct PREDICTEDMOVEMENT_API FMovementModifier
 {
 	/** The requested input state, which requests modifiers of the specified level */
 	TModifierStack WantsModifiers;
+
+	/**
+	 * Timestamp at which each of WantsModifiers expires, NO_MODIFIER_EXPIRY if it lasts until removed
+	 * Empty until a timed modifier is added, so untimed modifiers cost nothing to send
+	 */
+	TModifierExpiry WantsExpiry;
 	
 	/** The actual state, which represents the actual modifiers applied to the character */
 	TModifierStack Modifiers;
+
+	/** Expiry of each of Modifiers, empty if none are timed */
+	TModifierExpiry ModifiersExpiry;
+
+	/** Earliest of WantsExpiry, so the common case of nothing expiring is a single comparison */
+	float NextExpiry = NO_MODIFIER_EXPIRY;
+
+	/**
+	 * Slot of each of WantsModifiers, so a handle can find the modifier it added
+	 * Slots are assigned separately from the order of WantsModifiers, so reusing a slot never reorders the stack
+	 */
+	TModifierStack WantsSlots;
+
+	/** Generation of each slot, incremented when the slot is freed so old handles no longer match */
+	TArray<uint16> SlotGenerations;
+
+	/** Slots that are not assigned to any of WantsModifiers */
+	TModifierStack FreeSlots;
 	
 	/**
 	 * Adds a modifier to the stack
 	 * @param Level The level of the modifier to add
-	 * @return True if the modifier was added
+	 * @param Expiry Timestamp at which the modifier is removed, NO_MODIFIER_EXPIRY to last until removed
+	 * @return Handle that removes this modifier with RemoveModifierByHandle(), invalid if no slots remain
+	 */
+	FModifierHandle AddModifier(TModSize Level, float Expiry = NO_MODIFIER_EXPIRY);
+
+	/**
+	 * Removes the modifier that was added with this handle, without searching by level
+	 * @return True if the modifier was removed, false if the handle was invalid or the modifier was already removed
 	 */
-	bool AddModifier(TModSize Level)
+	bool RemoveModifierByHandle(const FModifierHandle& Handle);
+
+	/** @return True if the modifier added with this handle has not been removed */
+	bool IsHandleActive(const FModifierHandle& Handle) const
 	{
-		WantsModifiers.Add(Level);
-		return true;
+		// Freeing a slot increments the generation, so only the handle of the current modifier can match
+		return SlotGenerations.IsValidIndex(Handle.Slot) && SlotGenerations[Handle.Slot] == Handle.Generation;
 	}
 
 	/**
 	 * Removes a modifier from the stack
+	 * If only removing one, the first one found is removed, timed modifiers only if no untimed modifier matches
 	 * @param Level The level of the modifier to remove
 	 * @param bRemoveAll If true, removes all modifiers of the specified level, otherwise removes only one
 	 * @return True if the modifier was removed, false otherwise
 	 */
-	bool RemoveModifier(TModSize Level, bool bRemoveAll)
-	{
-		if (WantsModifiers.Contains(Level))
-		{
-			if (bRemoveAll)
-			{
-				WantsModifiers.Remove(Level);
-			}
-			else
-			{
-				WantsModifiers.RemoveSingle(Level);
-			}
-			return true;
-		}
-		return false;
-	}
+	bool RemoveModifier(TModSize Level, bool bRemoveAll);
 
 	/**
 	 * Removes all modifiers from the stack
@@ -222,11 +261,51 @@ struct PREDICTEDMOVEMENT_API FMovementModifier
 		if (WantsModifiers.Num() > 0)
 		{
 			WantsModifiers.Reset();
+			WantsExpiry.Reset();
+			NextExpiry = NO_MODIFIER_EXPIRY;
+			FreeAllSlots();
 			return true;
 		}
 		return false;
 	}
 
+	/**
+	 * Removes every modifier that has expired by the specified timestamp
+	 * Client and server call this with the same move timestamp, so expiry requires no correction
+	 * @return True if any modifiers were removed
+	 */
+	bool ExpireModifiers(float Timestamp)
+	{
+		return Timestamp >= NextExpiry && RemoveExpiredModifiers(Timestamp);
+	}
+
+	/** Offset every expiry, used when the timestamps they are based on are reset */
+	void RebaseExpiry(float Offset);
+
+	/**
+	 * Replace the requested modifiers, such as from a saved move or the network
+	 * Handles remain valid if the modifiers are unchanged, otherwise every handle is invalidated
+	 */
+	void SetWantsModifiers(const TModifierStack& InWantsModifiers, const TModifierExpiry& InWantsExpiry);
+
+	/** Restore the requested modifiers and their handles, after they were changed by replaying saved moves */
+	void RestoreWantsModifiers(const FMovementModifier& From);
+
+protected:
+	bool RemoveExpiredModifiers(float Timestamp);
+
+	/** Recalculate NextExpiry, and stop tracking expiry if no timed modifiers remain */
+	void UpdateNextExpiry();
+
+	/** Remove a single entry from WantsModifiers, along with its expiry and slot */
+	void RemoveWantedModifierAt(int32 Index);
+
+	/** @return Unused slot, or NO_MODIFIER if every slot is in use */
+	TModSize AllocateSlot();
+	void FreeSlot(TModSize Slot);
+	void FreeAllSlots();
+
+public:
 	/**
 	 * Returns the number of wanted modifiers in the stack that match the specified level
 	 * This is the requested modifiers, not the actual modifiers applied to the character
@@ -263,14 +342,14 @@ struct PREDICTEDMOVEMENT_API FMovementModifier_LocalPredicted : FMovementModifie
 	FMovementModifier_LocalPredicted()
 	{}
 
-	void ServerMove_PerformMovement(const TModifierStack& InWantsModifiers)
+	void ServerMove_PerformMovement(const TModifierStack& InWantsModifiers, const TModifierExpiry& InWantsExpiry)
 	{
-		WantsModifiers = InWantsModifiers;
+		SetWantsModifiers(InWantsModifiers, InWantsExpiry);
 	}
 
-	void CombineWith(const TModifierStack& InWantsModifiers)
+	void CombineWith(const TModifierStack& InWantsModifiers, const TModifierExpiry& InWantsExpiry)
 	{
-		WantsModifiers = InWantsModifiers;
+		SetWantsModifiers(InWantsModifiers, InWantsExpiry);
 	}
 };
 
@@ -291,9 +370,9 @@ struct PREDICTEDMOVEMENT_API FMovementModifier_WithCorrection final : FMovementM
 		return Modifiers != InModifiers;
 	}
 
-	void OnClientCorrectionReceived(const TModifierStack& InModifiers)
+	void OnClientCorrectionReceived(const TModifierStack& InModifiers, const TModifierExpiry& InExpiry)
 	{
-		WantsModifiers = InModifiers;
+		SetWantsModifiers(InModifiers, InExpiry);
 	}
 };
 
@@ -312,6 +391,16 @@ struct PREDICTEDMOVEMENT_API FModifierStatics
 	 */
 	static bool NetSerialize(TModifierStack& Modifiers, FArchive& Ar, const FString& ErrorName, uint8 MaxSerializedModifiers=8);
 
+	/**
+	 * Serializes the expiry of a modifier stack that has already been serialized, a single bit if none are timed
+	 * @param Expiry The expiry to serialize, either empty or parallel to Modifiers
+	 * @param Modifiers The modifier stack the expiry belongs to
+	 * @param Ar The archive to serialize to
+	 * @param MaxSerializedModifiers Must match the value used to serialize Modifiers
+	 * @return True if serialization was successful, false otherwise
+	 */
+	static bool NetSerializeExpiry(TModifierExpiry& Expiry, const TModifierStack& Modifiers, FArchive& Ar, uint8 MaxSerializedModifiers=8);
+
 	/**
 	 * Updates the modifier level based on the specified method
 	 * @param Method The method to use for updating the modifier level
@@ -330,7 +419,7 @@ struct PREDICTEDMOVEMENT_API FModifierStatics
 	 * @param InvalidLevel The level to return if no valid modifiers are found
 	 * @return The combined modifier level
 	 */
-	static TModSize CombineModifierLevels(EModifierLevelMethod Method, const TModifierStack& ModifierLevels, TModSize MaxLevel, TModSize InvalidLevel);
+	static TModSize CombineModifierLevels(EModifierLevelMethod Method, TArrayView<const TModSize> ModifierLevels, TModSize MaxLevel, TModSize InvalidLevel);
 
 	/**
 	 * Processes modifiers based on the specified method and updates the current level
@@ -347,4 +436,13 @@ struct PREDICTEDMOVEMENT_API FModifierStatics
 	static bool ProcessModifiers(TModSize& CurrentLevel, EModifierLevelMethod Method, const TArray<FGameplayTag>& LevelTags,
 		bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,	const TArray<FMovementModifier*>& Modifiers,
 		const TFunctionRef<bool()>& CanActivateCallback);
+
+	/**
+	 * Processes modifiers based on the specified method and updates the current level, without allocating
+	 * @param bCanActivate If the modifiers can be activated in the current state
+	 * @see ProcessModifiers
+	 */
+	static bool ProcessModifiers(TModSize& CurrentLevel, EModifierLevelMethod Method, const TArray<FGameplayTag>& LevelTags,
+		bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel, TArrayView<FMovementModifier* const> Modifiers,
+		bool bCanActivate);
 };
\ No newline at end of file
@@ -0,0 +1,78 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "ModifierTypes.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "ModifierLibrary.generated.h"
+
+class AModifierCharacter;
+
+/**
+ * Applies modifiers to many characters in a single call, such as for area of effect snares and auras
+ * The level index is resolved once and reused for every character that shares the same level tables,
+ * characters that aren't an AModifierCharacter are skipped
+ */
+UCLASS()
+class PREDICTEDMOVEMENT_API UModifierLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Boost every character in Targets, only characters we have authority over are Boosted
+	 * Locally predicted and corrected Boosts are only added to locally controlled characters, as a remote client's
+	 * next move would overwrite them, use ServerInitiated for everyone else
+	 * @param Targets Characters to Boost, e.g. the result of an overlap query
+	 * @param Level The level of the Boost to add
+	 * @param NetType How the Boost is applied, either locally predicted, with correction, or server initiated
+	 * @param Duration If greater than zero, the Boost is removed after this many seconds
+	 * @param Changed Characters that were Boosted
+	 * @param Handles Handle of the Boost added to each of Changed
+	 * @return Number of characters that were Boosted
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Character Movement: Modifiers", meta=(GameplayTagFilter="Modifier.Boost"))
+	static int32 BoostCharacters(const TArray<AActor*>& Targets, FGameplayTag Level, EModifierNetType NetType,
+		float Duration, TArray<AModifierCharacter*>& Changed, TArray<FModifierHandle>& Handles);
+
+	/**
+	 * Remove a Boost from every character in Targets, with the same restrictions as BoostCharacters()
+	 * @param bRemoveAll If true, removes all Boosts of the specified level, otherwise only removes one from each character
+	 * @param Changed Characters that had a Boost removed
+	 * @return Number of characters that had a Boost removed
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Character Movement: Modifiers", meta=(GameplayTagFilter="Modifier.Boost"))
+	static int32 UnBoostCharacters(const TArray<AActor*>& Targets, FGameplayTag Level, EModifierNetType NetType,
+		bool bRemoveAll, TArray<AModifierCharacter*>& Changed);
+
+	/**
+	 * Snare every character in Targets, only characters we have authority over are Snared
+	 * @param Targets Characters to Snare, e.g. the result of an overlap query
+	 * @param Level The level of the Snare to add
+	 * @param Duration If greater than zero, the Snare is removed after this many seconds
+	 * @param Changed Characters that were Snared
+	 * @param Handles Handle of the Snare added to each of Changed
+	 * @return Number of characters that were Snared
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Character Movement: Modifiers", meta=(GameplayTagFilter="Modifier.Snare"))
+	static int32 SnareCharacters(const TArray<AActor*>& Targets, FGameplayTag Level, float Duration,
+		TArray<AModifierCharacter*>& Changed, TArray<FModifierHandle>& Handles);
+
+	/**
+	 * Remove a Snare from every character in Targets, only characters we have authority over are affected
+	 * @param bRemoveAll If true, removes all Snares of the specified level, otherwise only removes one from each character
+	 * @param Changed Characters that had a Snare removed
+	 * @return Number of characters that had a Snare removed
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Character Movement: Modifiers", meta=(GameplayTagFilter="Modifier.Snare"))
+	static int32 UnSnareCharacters(const TArray<AActor*>& Targets, FGameplayTag Level, bool bRemoveAll,
+		TArray<AModifierCharacter*>& Changed);
+
+	/**
+	 * Resolve the index of Level, reusing CachedIndex if Levels has the same tag at that index
+	 * Characters of the same class share the same level tables, so this is a single comparison after the first
+	 */
+	static uint8 ResolveLevelIndex(const TArray<FGameplayTag>& Levels, const FGameplayTag& Level, uint8& CachedIndex);
+};
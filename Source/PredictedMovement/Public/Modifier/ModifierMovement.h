@@ -4,17 +4,23 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "ModifierDefinition.h"
 #include "ModifierImpl.h"
 #include "ModifierTypes.h"
+#include "ModifierZoneSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "System/AdaptiveCorrection.h"
 #include "System/PredictedMovementVersioning.h"
 #include "ModifierMovement.generated.h"
 
+class AController;
 class AModifierCharacter;
+class UPhysicalMaterial;
 
 using TMod_Local = FMovementModifier_LocalPredicted;
 using TMod_LocalCorrection = FMovementModifier_WithCorrection;
 using TMod_Server = FMovementModifier_WithCorrection;
+using TMod_Zone = FMovementModifier;
 
 struct PREDICTEDMOVEMENT_API FModifierMoveResponseDataContainer : FCharacterMoveResponseDataContainer
 {  // Server ➜ Client
@@ -93,12 +99,84 @@ private:
 	UPROPERTY(Transient, DuplicateTransient)
 	TObjectPtr<AModifierCharacter> ModifierCharacterOwner;
 
+public:
+	/**
+	 * Shared Boost, Snare, SlowFall and client auth definitions, compiled once and referenced by every character
+	 * If set, Boost, Snare, SlowFall and ClientAuthParams below are ignored, and emptied at runtime to free them
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadOnly)
+	TObjectPtr<UModifierDefinition> ModifierDefinition;
+
+protected:
+	/** Compiled from ModifierDefinition, or from our own maps if not set */
+	TSharedPtr<const FModifierTables> ModifierTables;
+
+	/** True if ModifierTables is ours alone, false if shared with other characters */
+	bool bOwnsModifierTables = false;
+
+	/** Memory used by ModifierTables if owned, or saved by sharing them */
+	SIZE_T ModifierTablesOwnedSize = 0;
+	SIZE_T ModifierTablesSavedSize = 0;
+
+	/** @return ModifierTables, copied first if shared, so overrides only affect this character */
+	FModifierTables& GetMutableModifierTables();
+
+	/** Levels and client auth sources changed by Override*Params(), kept when ModifierDefinition is reloaded */
+	TSet<FGameplayTag> OverriddenModifierParams;
+
+	/** Bound to OnTablesChanged of the definition we took our tables from */
+	TWeakObjectPtr<UModifierDefinition> BoundModifierDefinition;
+	FDelegateHandle ModifierDefinitionChangedHandle;
+
+	void UnbindModifierDefinition();
+
+	/**
+	 * Take the params of ModifierDefinition's recompiled tables, keeping any overrides
+	 * Level changes are refused, as active modifiers and saved moves hold indexes into the current levels
+	 */
+	virtual void OnModifierDefinitionChanged();
+
+public:
+	const FModifierTables& GetModifierTables() const { return *ModifierTables; }
+
+	/** Indexed list of levels, used to determine the current level based on index */
+	const TArray<FGameplayTag>& GetBoostLevels() const { return ModifierTables->BoostLevels; }
+	const TArray<FGameplayTag>& GetSnareLevels() const { return ModifierTables->SnareLevels; }
+	const TArray<FGameplayTag>& GetSlowFallLevels() const { return ModifierTables->SlowFallLevels; }
+
+	/**
+	 * Override the params of an existing level for this character only, copying the shared tables if needed
+	 * Must be applied identically on client and server
+	 * @return False if the level doesn't exist, levels can't be added as that would change their indexes
+	 */
+	UFUNCTION(BlueprintCallable, Category="Character Movement", meta=(Categories="Modifier.Boost"))
+	bool OverrideBoostParams(FGameplayTag Level, const FMovementModifierParams& Params);
+
+	/** @see OverrideBoostParams */
+	UFUNCTION(BlueprintCallable, Category="Character Movement", meta=(Categories="Modifier.Snare"))
+	bool OverrideSnareParams(FGameplayTag Level, const FMovementModifierParams& Params);
+
+	/** @see OverrideBoostParams */
+	UFUNCTION(BlueprintCallable, Category="Character Movement", meta=(Categories="Modifier.SlowFall"))
+	bool OverrideSlowFallParams(FGameplayTag Level, const FFallingModifierParams& Params);
+
+	/** Override or add the client auth params of a source for this character only, copying the shared tables if needed */
+	UFUNCTION(BlueprintCallable, Category="Character Movement (Networking)")
+	void OverrideClientAuthParams(FGameplayTag Source, const FClientAuthParams& Params);
+
+	/** @return Bytes this character saves by sharing ModifierDefinition's tables instead of owning its own */
+	UFUNCTION(BlueprintPure, Category="Character Movement")
+	int64 GetModifierTablesMemorySaved() const { return ModifierTablesSavedSize; }
+
 public:
 	/**
 	 * Boost modifies movement properties such as speed and acceleration
 	 * Scaling applied on a per-Boost-level basis
+	 * Compiled into ModifierTables on register, changes afterwards only apply after BuildModifierLevels()
+	 * Ignored if ModifierDefinition is set, and emptied at runtime to free them
+	 * Use OverrideBoostParams() to change params at runtime
 	 */
-	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadOnly)
 	TMap<FGameplayTag, FMovementModifierParams> Boost;
 
 	/**
@@ -119,10 +197,6 @@ public:
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin=1, UIMin=1, UIMax=32, EditCondition="bLimitMaxBoosts"))
 	int32 MaxBoosts = 8;
 
-	/** Indexed list of Boost levels, used to determine the current Boost level based on index */
-	UPROPERTY()
-	TArray<FGameplayTag> BoostLevels;
-
 	/** The method used to calculate Boost levels */
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
 	EModifierLevelMethod BoostLevelMethod;
@@ -136,12 +210,21 @@ public:
 	/** Server Initiated Boost that is sent to the Client via a correction */
 	TMod_Server BoostServer;
 
+	/** Boost from UModifierZoneComponent, evaluated from position by both Client and Server */
+	TMod_Zone BoostZone;
+
+	/** Boost from the physical material of the floor, evaluated by both Client and Server */
+	TMod_Zone BoostSurface;
+
 public:
 	/**
 	 * Snare modifies movement properties such as speed and acceleration
 	 * Scaling applied on a per-Snare-level basis
+	 * Compiled into ModifierTables on register, changes afterwards only apply after BuildModifierLevels()
+	 * Ignored if ModifierDefinition is set, and emptied at runtime to free them
+	 * Use OverrideSnareParams() to change params at runtime
 	 */
-	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadOnly)
 	TMap<FGameplayTag, FMovementModifierParams> Snare;
 
 	/**
@@ -160,10 +243,6 @@ public:
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin=1, UIMin=1, UIMax=32, EditCondition="bLimitMaxSnares"))
 	int32 MaxSnares = 8;
 
-	/** Indexed list of Snare levels, used to determine the current Snare level based on index */
-	UPROPERTY()
-	TArray<FGameplayTag> SnareLevels;
-
 	/** The method used to calculate Snare levels */
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
 	EModifierLevelMethod SnareLevelMethod;
@@ -171,12 +250,21 @@ public:
 	/** Server Initiated Snare that is sent to the Client via a correction */
 	TMod_Server SnareServer;
 
+	/** Snare from UModifierZoneComponent, evaluated from position by both Client and Server */
+	TMod_Zone SnareZone;
+
+	/** Snare from the physical material of the floor, evaluated by both Client and Server */
+	TMod_Zone SnareSurface;
+
 public:
 	/**
 	 * SlowFall changes falling properties, such as gravity and air control
 	 * Scaling applied on a per-SlowFall-level basis
+	 * Compiled into ModifierTables on register, changes afterwards only apply after BuildModifierLevels()
+	 * Ignored if ModifierDefinition is set, and emptied at runtime to free them
+	 * Use OverrideSlowFallParams() to change params at runtime
 	 */
-	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadOnly)
 	TMap<FGameplayTag, FFallingModifierParams> SlowFall;
 
 	/**
@@ -197,19 +285,23 @@ public:
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin=1, UIMin=1, UIMax=32, EditCondition="bLimitMaxSlowFalls"))
 	int32 MaxSlowFalls = 8;
 
-	/** Indexed list of SlowFall levels, used to determine the current SlowFall level */
-	UPROPERTY()
-	TArray<FGameplayTag> SlowFallLevels;
-
 	/** The method used to calculate SlowFall levels */
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
 	EModifierLevelMethod SlowFallLevelMethod;
 
 	/** Local Predicted SlowFall based on Player Input */
 	TMod_Local SlowFallLocal;
-	
+
+	/** SlowFall from UModifierZoneComponent, evaluated from position by both Client and Server */
+	TMod_Zone SlowFallZone;
+
 public:
-	/** Client auth parameters mapped to a source gameplay tag */
+	/**
+	 * Client auth parameters mapped to a source gameplay tag
+	 * Compiled into ModifierTables on register, changes afterwards only apply after BuildModifierLevels()
+	 * Ignored if ModifierDefinition is set, and emptied at runtime to free them
+	 * Use OverrideClientAuthParams() to change params at runtime
+	 */
 	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly)
 	TMap<FGameplayTag, FClientAuthParams> ClientAuthParams;
 
@@ -221,14 +313,43 @@ public:
 
 	UPROPERTY()
 	uint64 ClientAuthIdCounter = 0;
+
+	/**
+	 * Optionally widen or tighten MaxClientAuthDistance and RejectClientAuthDistance per connection based on the
+	 * positional error measured from that connection. Server only.
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly)
+	FAdaptiveCorrectionParams AdaptiveClientAuthCorrection;
+
+protected:
+	FAdaptiveCorrectionState AdaptiveClientAuthState;
+
+	/** The measured error belongs to the previous connection, start over */
+	UFUNCTION()
+	virtual void OnPawnControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+public:
+	/** @return Scale applied to the client auth distances for this connection by AdaptiveClientAuthCorrection */
+	UFUNCTION(BlueprintPure, Category="Character Movement (Networking)")
+	float GetClientAuthDistanceScale() const { return AdaptiveClientAuthState.GetScale(AdaptiveClientAuthCorrection); }
+
+	/** @return Measured positional error statistics for this connection, only populated on the server */
+	const FAdaptiveCorrectionState& GetAdaptiveClientAuthState() const { return AdaptiveClientAuthState; }
 	
 public:
 	UModifierMovement(const FObjectInitializer& ObjectInitializer);
 
 	virtual bool HasValidData() const override;
 	virtual void PostLoad() override;
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 public:
 	virtual float GetMaxAcceleration() const override;
 	virtual float GetMaxSpeed() const override;
@@ -248,9 +369,9 @@ public:
 
 	uint8 BoostLevel = NO_MODIFIER;
 	bool IsBoostActive() const { return BoostLevel != NO_MODIFIER; }
-	const FMovementModifierParams* GetBoostParams() const { return Boost.Find(GetBoostLevel()); }
-	FGameplayTag GetBoostLevel() const { return BoostLevels.IsValidIndex(BoostLevel) ? BoostLevels[BoostLevel] : FGameplayTag::EmptyTag; }
-	uint8 GetBoostLevelIndex(const FGameplayTag& Level) const { return BoostLevels.IndexOfByKey(Level) > INDEX_NONE ? BoostLevels.IndexOfByKey(Level) : NO_MODIFIER; }
+	const FMovementModifierParams* GetBoostParams() const { return ModifierTables->GetBoostParams(BoostLevel); }
+	FGameplayTag GetBoostLevel() const { return GetBoostLevels().IsValidIndex(BoostLevel) ? GetBoostLevels()[BoostLevel] : FGameplayTag::EmptyTag; }
+	uint8 GetBoostLevelIndex(const FGameplayTag& Level) const { const int32 Index = GetBoostLevels().IndexOfByKey(Level); return Index > INDEX_NONE ? Index : NO_MODIFIER; }
 	virtual bool CanBoostInCurrentState() const;
 
 	float GetBoostSpeedScalar() const { return GetBoostParams() ? GetBoostParams()->MaxWalkSpeed : 1.f; }
@@ -267,9 +388,9 @@ public:
 
 	uint8 SnareLevel = NO_MODIFIER;
 	bool IsSnareActive() const { return SnareLevel != NO_MODIFIER; }
-	const FMovementModifierParams* GetSnareParams() const { return Snare.Find(GetSnareLevel()); }
-	FGameplayTag GetSnareLevel() const { return SnareLevels.IsValidIndex(SnareLevel) ? SnareLevels[SnareLevel] : FGameplayTag::EmptyTag; }
-	uint8 GetSnareLevelIndex(const FGameplayTag& Level) const { return SnareLevels.IndexOfByKey(Level) > INDEX_NONE ? SnareLevels.IndexOfByKey(Level) : NO_MODIFIER; }
+	const FMovementModifierParams* GetSnareParams() const { return ModifierTables->GetSnareParams(SnareLevel); }
+	FGameplayTag GetSnareLevel() const { return GetSnareLevels().IsValidIndex(SnareLevel) ? GetSnareLevels()[SnareLevel] : FGameplayTag::EmptyTag; }
+	uint8 GetSnareLevelIndex(const FGameplayTag& Level) const { const int32 Index = GetSnareLevels().IndexOfByKey(Level); return Index > INDEX_NONE ? Index : NO_MODIFIER; }
 	virtual bool CanSnareInCurrentState() const;
 
 	float GetSnareSpeedScalar() const { return GetSnareParams() ? GetSnareParams()->MaxWalkSpeed : 1.f; }
@@ -286,9 +407,9 @@ public:
 
 	uint8 SlowFallLevel = NO_MODIFIER;
 	bool IsSlowFallActive() const { return SlowFallLevel != NO_MODIFIER; }
-	const FFallingModifierParams* GetSlowFallParams() const { return SlowFall.Find(GetSlowFallLevel()); }
-	FGameplayTag GetSlowFallLevel() const { return SlowFallLevels.IsValidIndex(SlowFallLevel) ? SlowFallLevels[SlowFallLevel] : FGameplayTag::EmptyTag; }
-	uint8 GetSlowFallLevelIndex(const FGameplayTag& Level) const { return SlowFallLevels.IndexOfByKey(Level) > INDEX_NONE ? SlowFallLevels.IndexOfByKey(Level) : NO_MODIFIER; }
+	const FFallingModifierParams* GetSlowFallParams() const { return ModifierTables->GetSlowFallParams(SlowFallLevel); }
+	FGameplayTag GetSlowFallLevel() const { return GetSlowFallLevels().IsValidIndex(SlowFallLevel) ? GetSlowFallLevels()[SlowFallLevel] : FGameplayTag::EmptyTag; }
+	uint8 GetSlowFallLevelIndex(const FGameplayTag& Level) const { const int32 Index = GetSlowFallLevels().IndexOfByKey(Level); return Index > INDEX_NONE ? Index : NO_MODIFIER; }
 	virtual bool CanSlowFallInCurrentState() const;
 
 	virtual float GetSlowFallGravityZScalar() const { return GetSlowFallParams() ? GetSlowFallParams()->GetGravityScalar(Velocity) : 1.f; }
@@ -296,7 +417,180 @@ public:
 
 	/* ~SlowFall Implementation */
 
+protected:
+	/** Timestamp of the last call to ExpireModifiers(), used to detect timestamp resets */
+	float LastModifierTimestamp = -1.f;
+
+	/** Timestamp of the saved move being replayed, so GetModifierTimestamp() matches the server during replays */
+	float ReplayingMoveTimestamp = -1.f;
+
+public:
+	/** @return Predicted timestamp that modifier expiry is based on, matches between client and server for the same move */
+	float GetModifierTimestamp() const;
+
+	/**
+	 * @param Duration How long the modifier lasts, in seconds
+	 * @return Timestamp at which a modifier added now should expire, NO_MODIFIER_EXPIRY if Duration is not positive
+	 */
+	float GetModifierExpiry(float Duration) const;
+
+	/** Remove timed modifiers that have expired by the current move's timestamp */
+	virtual void ExpireModifiers();
+
 public:
+	/**
+	 * If true, query UModifierZoneSubsystem once per move for the zones containing the character
+	 * Zones are evaluated from position by both Client and Server, so they need no replication or overlap events
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
+	bool bEnableModifierZones = true;
+
+protected:
+	/** Reused by UpdateZoneModifiers() to avoid allocating each move */
+	TModifierZoneQuery ZoneQuery;
+
+public:
+	/** Apply the levels of every UModifierZoneComponent containing the character to the zone modifiers */
+	virtual void UpdateZoneModifiers();
+
+public:
+	/**
+	 * Boost or Snare level applied while walking on a floor with the physical material, e.g. ice or mud
+	 * Evaluated from the floor by both Client and Server, so it needs no corrections
+	 * Call RefreshSurfaceModifiers() after modifying at runtime
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(Categories="Modifier"))
+	TMap<TObjectPtr<UPhysicalMaterial>, FGameplayTag> SurfaceModifiers;
+
+protected:
+	/** Floor that SurfaceModifierCache was resolved for, so the lookup only happens when the floor changes */
+	TWeakObjectPtr<const UPrimitiveComponent> SurfaceCacheComponent;
+	TWeakObjectPtr<const UPhysicalMaterial> SurfaceCacheMaterial;
+	FGameplayTag SurfaceCacheType;
+	uint8 SurfaceCacheLevel = NO_MODIFIER;
+	bool bSurfaceCached = false;
+
+public:
+	/** Discard the cached surface modifier, call after modifying SurfaceModifiers at runtime */
+	UFUNCTION(BlueprintCallable, Category="Character Movement")
+	void RefreshSurfaceModifiers() { bSurfaceCached = false; }
+
+	/** @return Physical material of the floor the character is walking on, if any */
+	virtual UPhysicalMaterial* GetFloorPhysicalMaterial() const;
+
+	/** Apply the level mapped to the floor's physical material by SurfaceModifiers to the surface modifiers */
+	virtual void UpdateSurfaceModifiers();
+
+public:
+	/**
+	 * If true, server controlled AI skip the prediction bookkeeping, and only compute their effective modifier levels
+	 * once per tick, which are then replicated to simulated proxies
+	 * Modifiers are not evaluated again after movement, so a change in movement mode applies on the next tick
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers|AI", EditAnywhere, BlueprintReadWrite)
+	bool bEnableAIFastPath = false;
+
+	/**
+	 * If true, AI on the fast path don't dispatch OnModifierAdded, OnModifierChanged or OnModifierRemoved
+	 * Modifier levels still replicate to simulated proxies, which dispatch the events as usual
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers|AI", EditAnywhere, BlueprintReadWrite, meta=(EditCondition="bEnableAIFastPath"))
+	bool bAIFastPathSuppressEvents = false;
+
+	/**
+	 * AI on the fast path that are further than this from every player update their modifiers every
+	 * AIThrottledUpdateInterval instead of every tick, 0 to disable
+	 * Changes to their modifiers are delayed by up to AIThrottledUpdateInterval
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers|AI", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", ForceUnits="cm", EditCondition="bEnableAIFastPath"))
+	float AIThrottleDistance = 0.f;
+
+	/** How often AI beyond AIThrottleDistance update their modifiers */
+	UPROPERTY(Category="Character Movement: Modifiers|AI", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", ForceUnits="s", EditCondition="bEnableAIFastPath"))
+	float AIThrottledUpdateInterval = 0.25f;
+
+protected:
+	/** Time since AI on the fast path last updated their modifiers */
+	float AIModifierUpdateTime = 0.f;
+
+	/** Interval until AI on the fast path next update their modifiers, from GetAIModifierUpdateInterval() */
+	float AIModifierUpdateInterval = 0.f;
+
+public:
+	/** @return True if server controlled AI, which has no saved moves or move data, and can use the fast path */
+	bool IsAIFastPath() const;
+
+	/**
+	 * @return Interval between modifier updates for AI on the fast path, 0 to update every tick
+	 * Override to throttle by significance instead of distance
+	 */
+	virtual float GetAIModifierUpdateInterval() const;
+
+	/** Compute the effective modifier levels for AI on the fast path */
+	virtual void UpdateAIModifierMovementState(float DeltaSeconds);
+
+protected:
+	/** Replicate a modifier changed by UpdateAIModifierMovementState(), and dispatch events unless suppressed */
+	void NotifyAIModifierChanged(const FGameplayTag& ModifierType, const TArray<FGameplayTag>& Levels, uint8 Level, uint8 PrevLevel) const;
+
+public:
+	/**
+	 * If true, modifiers are evaluated once per move, before movement, instead of both before and after movement
+	 * After movement they are only evaluated again if the movement mode or physics simulation changed during the move,
+	 * as that is the only state CanBoostInCurrentState() and similar depend on by default
+	 * Client and server evaluate at the same points of the same moves, so this doesn't affect prediction, but changes
+	 * made to modifiers between moves are applied at the start of the next move instead of the end of the current one
+	 * Override ShouldUpdateModifiersAfterMovement() if your CanXInCurrentState() depends on other state
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
+	bool bSinglePassModifierUpdate = false;
+
+protected:
+	/** State before movement, used to determine if modifiers need to be evaluated again after movement */
+	TEnumAsByte<EMovementMode> PreMoveMovementMode = MOVE_None;
+	uint8 PreMoveCustomMovementMode = 0;
+	bool bPreMoveSimulatingPhysics = false;
+
+	/** @return True if modifiers need to be evaluated again after movement */
+	virtual bool ShouldUpdateModifiersAfterMovement() const;
+
+public:
+	/**
+	 * Build ModifierTables from ModifierDefinition, or from Boost, Snare, SlowFall and ClientAuthParams if not set
+	 * Levels are sorted in natural tag order, so that indexes match between client and server regardless of the
+	 * order the levels were added in, e.g. Modifier.Boost.Level2 is before Modifier.Boost.Level10
+	 * Called on register, only call again if the levels are modified identically on client and server
+	 * Discards any overrides
+	 */
+	UFUNCTION(BlueprintCallable, Category="Character Movement")
+	void BuildModifierLevels();
+
+	/** @return Checksum of the level tables, which must match between client and server */
+	uint32 GetModifierLevelsChecksum() const { return ModifierTables->Checksum; }
+
+	/** @return Checksum of the level tables and their params, which should match between client and server */
+	uint32 GetModifierTablesVersion() const { return ModifierTables->Version; }
+
+	/**
+	 * Send the checksum and version of the tables to the server
+	 * Called by the owning client when the pawn is restarted, and when the tables are reloaded
+	 */
+	void VerifyModifierLevels();
+
+protected:
+	/** Compare the client's tables to our own, and report any mismatch */
+	UFUNCTION(Server, Reliable)
+	void ServerVerifyModifierLevels(uint32 ClientChecksum, uint32 ClientVersion);
+
+	/** Compare the server's reloaded tables to our own, and report any mismatch */
+	UFUNCTION(Client, Reliable)
+	void ClientVerifyModifierLevels(uint32 ServerChecksum, uint32 ServerVersion);
+
+	/** Report any mismatch between our tables and the remote tables */
+	void CompareModifierTables(uint32 RemoteChecksum, uint32 RemoteVersion, const TCHAR* Remote) const;
+
+public:
+
 	virtual void ProcessModifierMovementState();
 	virtual void UpdateModifierMovementState();
 
@@ -307,7 +601,7 @@ public:
 	/* Client Auth Implementation */
 
 	virtual FClientAuthData* ProcessClientAuthData();
-	FClientAuthParams* GetClientAuthParamsForSource(const FGameplayTag& Source) { return ClientAuthParams.Find(Source); }
+	const FClientAuthParams* GetClientAuthParamsForSource(const FGameplayTag& Source) const { return ModifierTables->ClientAuthParams.Find(Source); }
 	virtual FClientAuthParams GetClientAuthParams(const FClientAuthData* ClientAuthData);
 
 protected:
@@ -361,6 +655,8 @@ protected:
 
 	virtual bool ClientUpdatePositionAfterServerUpdate() override;
 
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
 protected:
 	virtual void TickCharacterPose(float DeltaTime) override;  // ACharacter::GetAnimRootMotionTranslationScale() is non-virtual so we have to duplicate this entire function
 	
@@ -42,6 +42,14 @@ enum class EModifierLevelMethod : uint8
 	Average 			UMETA(ToolTip="The average modifier level will be applied"),
 };
 
+UENUM(BlueprintType)
+enum class EModifierProxyLOD : uint8
+{
+	Disabled			UMETA(ToolTip="Every simulated proxy dispatches modifier events as soon as they replicate"),
+	Defer				UMETA(ToolTip="Insignificant simulated proxies dispatch the latest modifier changes once they become significant again"),
+	Drop				UMETA(ToolTip="Insignificant simulated proxies never dispatch modifier events, for events that only trigger one-shot cosmetics"),
+};
+
 UENUM(BlueprintType)
 enum class EModifierFallZ : uint8
 {
@@ -51,6 +59,61 @@ enum class EModifierFallZ : uint8
 	Rising				UMETA(ToolTip="Remove Velocity.Z when modifier starts, but only if the character is rising (Velocity.Z > 0)"),
 };
 
+/**
+ * Identifies a single modifier added by Boost(), Snare() or SlowFall(), so it can be removed without removing another
+ * modifier of the same level that was added by something else
+ * Only valid on the machine that added the modifier
+ */
+USTRUCT(BlueprintType)
+struct PREDICTEDMOVEMENT_API FModifierHandle
+{
+	GENERATED_BODY()
+
+	FModifierHandle()
+		: Slot(NO_MODIFIER)
+		, NetType(EModifierNetType::LocalPredicted)
+		, Generation(0)
+	{}
+
+	FModifierHandle(uint8 InSlot, uint16 InGeneration, EModifierNetType InNetType = EModifierNetType::LocalPredicted)
+		: Slot(InSlot)
+		, NetType(InNetType)
+		, Generation(InGeneration)
+	{}
+
+	/** Slot within the modifier stack, NO_MODIFIER if invalid */
+	UPROPERTY()
+	uint8 Slot;
+
+	/** Which stack the modifier was added to */
+	UPROPERTY()
+	EModifierNetType NetType;
+
+	/** Modifier.Boost, Modifier.Snare or Modifier.SlowFall, slots are allocated per modifier so they overlap */
+	UPROPERTY()
+	FGameplayTag ModifierType;
+
+	/** Incremented each time the slot is freed, so the handle no longer matches once the modifier is removed */
+	UPROPERTY()
+	uint16 Generation;
+
+	bool IsValid() const { return Slot != NO_MODIFIER; }
+
+	/** @return True if the handle was returned when adding ModifierType via InNetType */
+	bool IsFor(const FGameplayTag& InModifierType, EModifierNetType InNetType) const
+	{
+		return IsValid() && ModifierType == InModifierType && NetType == InNetType;
+	}
+	explicit operator bool() const { return IsValid(); }
+
+	bool operator==(const FModifierHandle& Other) const
+	{
+		return Slot == Other.Slot && NetType == Other.NetType && Generation == Other.Generation &&
+			ModifierType == Other.ModifierType;
+	}
+	bool operator!=(const FModifierHandle& Other) const { return !(*this == Other); }
+};
+
 /**
  * Parameters for a modifier that affects character movement
  */
@@ -110,6 +173,9 @@ struct PREDICTEDMOVEMENT_API FMovementModifierParams
 	bool bAffectsRootMotion;
 };
 
+/** Number of samples when baking FFallingModifierParams::GravityScalarFallVelocityCurve */
+static constexpr int32 GravityScalarTableSize = 64;
+
 /**
  * Parameters for a modifier that affects falling
  */
@@ -126,7 +192,15 @@ struct PREDICTEDMOVEMENT_API FFallingModifierParams
 		, bOverrideAirControl(false)
 		, AirControlScalar(1.f)
 		, AirControlOverride(1.f)
-	{}
+		, GravityScalarTableMinZ(0.f)
+		, GravityScalarTableInvStep(0.f)
+		, bGravityScalarTableBaked(false)
+	{
+		for (float& Sample : GravityScalarTable)
+		{
+			Sample = 1.f;
+		}
+	}
 
 	/** If true, use GravityScalarFallVelocityCurve */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier)
@@ -162,18 +236,47 @@ struct PREDICTEDMOVEMENT_API FFallingModifierParams
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, meta=(EditCondition="bOverrideAirControl", EditConditionHides))
 	float AirControlOverride;
 
+protected:
+	/** GravityScalarFallVelocityCurve sampled uniformly over the time range of the curve */
+	float GravityScalarTable[GravityScalarTableSize];
+
+	/** Velocity.Z of the first sample */
+	float GravityScalarTableMinZ;
+
+	/** Samples per unit of Velocity.Z */
+	float GravityScalarTableInvStep;
+
+	bool bGravityScalarTableBaked;
+
+public:
+	/**
+	 * Sample GravityScalarFallVelocityCurve into a table, so the curve is never evaluated during movement
+	 * Velocity.Z beyond the range of the curve uses the first or last sample
+	 */
+	void BakeGravityScalarTable();
+
+	bool IsGravityScalarTableBaked() const { return bGravityScalarTableBaked; }
+
 	/**
 	 * Get the gravity scalar based on the current velocity.
-	 * If bGravityScalarFromVelocityZ is true, uses GravityScalarFallVelocityCurve to determine the scalar based on Velocity.Z.
+	 * If bGravityScalarFromVelocityZ is true, interpolates the baked GravityScalarFallVelocityCurve based on Velocity.Z.
 	 * Otherwise, returns GravityScalar.
 	 */
 	float GetGravityScalar(const FVector& Velocity) const
 	{
-		if (!ensureMsgf(!bGravityScalarFromVelocityZ || GravityScalarFallVelocityCurve != nullptr, TEXT("GravityScalarFallVelocityCurve must be set")))
+		if (!bGravityScalarFromVelocityZ)
 		{
-			return 1.f;
+			return GravityScalar;
 		}
-		return bGravityScalarFromVelocityZ ? GravityScalarFallVelocityCurve->GetFloatValue(Velocity.Z) : GravityScalar;
+
+		if (!bGravityScalarTableBaked)
+		{
+			return GravityScalarFallVelocityCurve ? GravityScalarFallVelocityCurve->GetFloatValue(Velocity.Z) : 1.f;
+		}
+
+		const float Sample = FMath::Clamp<float>((Velocity.Z - GravityScalarTableMinZ) * GravityScalarTableInvStep, 0.f, GravityScalarTableSize - 1);
+		const int32 Index = FMath::Min<int32>(FMath::FloorToInt(Sample), GravityScalarTableSize - 2);
+		return FMath::Lerp(GravityScalarTable[Index], GravityScalarTable[Index + 1], Sample - Index);
 	}
 
 	/**
@@ -258,35 +361,28 @@ struct PREDICTEDMOVEMENT_API FClientAuthData
 
 	FClientAuthData()
 		: Alpha(0.f)
-		, TimeRemaining(0.f)
+		, ExpiryTime(0.0)
 		, Id(0)
 		, Source(FGameplayTag::EmptyTag)
 		, Priority(99)
 	{}
 
-	FClientAuthData(const FGameplayTag& InSource, float InTimeRemaining, int32 InPriority, uint64 InId)
+	FClientAuthData(const FGameplayTag& InSource, double InExpiryTime, const FClientAuthParams& InParams, uint64 InId)
 		: Alpha(0.f)
-		, TimeRemaining(InTimeRemaining)
+		, ExpiryTime(InExpiryTime)
 		, Id(InId)
 		, Source(InSource)
-		, Priority(InPriority)
-	{}
-
-	FClientAuthData(const FGameplayTag& InSource, float InTimeRemaining, float InAlpha, int32 InPriority, uint64 InId)
-		: Alpha(InAlpha)
-		, TimeRemaining(InTimeRemaining)
-		, Id(InId)
-		, Source(InSource)
-		, Priority(InPriority)
+		, Priority(InParams.Priority)
+		, Params(InParams)
 	{}
 
 	/** The alpha value of the client auth data, used to determine how much authority the client has */
 	UPROPERTY()
 	float Alpha;
 
-	/** The time remaining for the client to have positional authority */
+	/** FClientAuthStack::Time at which the client loses positional authority */
 	UPROPERTY()
-	float TimeRemaining;
+	double ExpiryTime;
 
 	UPROPERTY()
 	uint64 Id;
@@ -302,6 +398,10 @@ struct PREDICTEDMOVEMENT_API FClientAuthData
 	UPROPERTY()
 	int32 Priority;
 
+	/** Params of the source when authority was granted */
+	UPROPERTY()
+	FClientAuthParams Params;
+
 	bool IsValid() const
 	{
 		return Id != 0 && Source.IsValid();
@@ -320,18 +420,43 @@ struct PREDICTEDMOVEMENT_API FClientAuthData
 
 /**
  * Stack of client auth data for providing client with positional authority
+ * Holds at most MaxEntries, always ordered by priority, so the server never sorts or allocates
  */
 USTRUCT()
 struct PREDICTEDMOVEMENT_API FClientAuthStack
 {
 	GENERATED_BODY()
 
+	/** IMPORTANT: We do not allow serializing more than 8, if this changes, update the serialization code too */
+	static constexpr int32 MaxEntries = 8;
+
 	FClientAuthStack()
 	{}
 
-	/** Stack of client auth data */
-	UPROPERTY()
-	TArray<FClientAuthData> Stack;
+protected:
+	/** Stack of client auth data, ordered by priority, then by the order they were added */
+	TArray<FClientAuthData, TFixedAllocator<MaxEntries>> Stack;
+
+	/** Accumulated time of the moves received from the client, that ExpiryTime is based on */
+	double Time = 0.0;
+
+	/** Earliest ExpiryTime in the stack, so the common case of nothing expiring is a single comparison */
+	double NextExpiry = MAX_dbl;
+
+	/** Combined params of every entry sharing the most important priority */
+	FClientAuthParams TopParams = { false, 0.f, 0.f, 0.f, INT32_MAX };
+
+public:
+	/** @return Stack of client auth data, modify it through Push() and the Remove functions only */
+	const TArray<FClientAuthData, TFixedAllocator<MaxEntries>>& GetStack() const { return Stack; }
+
+	int32 Num() const { return Stack.Num(); }
+
+	/** @return Accumulated time of the moves received from the client */
+	double GetTime() const { return Time; }
+
+	/** @return Earliest ExpiryTime in the stack */
+	double GetNextExpiry() const { return NextExpiry; }
 
 	bool operator==(const FClientAuthStack& Other) const
 	{
@@ -344,48 +469,40 @@ struct PREDICTEDMOVEMENT_API FClientAuthStack
 	}
 
 	/**
-	 * Sorts the stack by priority, in ascending order
-	 * Lower priority values are more important
-	 */
-	void SortByPriority()
-	{
-		Stack.Sort([](const FClientAuthData& A, const FClientAuthData& B)
-		{
-			return A.Priority < B.Priority;
-		});
-	}
-
-	/**
-	 * Filters the stack by priority, returning only the data with the specified priority
-	 * @param Priority The priority to filter by
-	 * @return An array of FClientAuthData with the specified priority
+	 * Add client auth data, keeping the stack ordered by priority
+	 * If the stack is full, the oldest entry is removed
+	 * @param Source The source the client is given authority for
+	 * @param Params Params of the source
+	 * @param Duration How long the client has authority, in seconds
+	 * @param Id Unique id of the entry
 	 */
-	TArray<FClientAuthData> FilterPriority(int32 Priority) const
-	{
-		return Stack.FilterByPredicate([Priority](const FClientAuthData& AuthData)
-		{
-			return AuthData.Priority == Priority;
-		});
-	}
+	void Push(const FGameplayTag& Source, const FClientAuthParams& Params, float Duration, uint64 Id);
 
 	/**
-	 * Determines the lowest priority in the stack
+	 * Advance Time, and remove any data that has expired
+	 * @param DeltaTime Duration of the move received from the client
 	 */
-	int32 DetermineLowestPriority()
+	void Advance(float DeltaTime)
 	{
-		if (Stack.Num() == 0)
+		Time += DeltaTime;
+		if (Time >= NextExpiry)
 		{
-			return INT32_MAX;
+			RemoveExpired();
 		}
-		SortByPriority();
-		return Stack[0].Priority;
 	}
 
-	TArray<FClientAuthData> GetLowestPriority()
+	/** @return Time remaining for the client to have positional authority from this data */
+	float GetTimeRemaining(const FClientAuthData& Data) const
 	{
-		return FilterPriority(DetermineLowestPriority());
+		return static_cast<float>(Data.ExpiryTime - Time);
 	}
 
+	/**
+	 * @param Priority The priority to combine the params for
+	 * @return Averaged params of every entry with the specified priority, cached for the most important priority
+	 */
+	FClientAuthParams GetParams(int32 Priority) const;
+
 	FClientAuthData* GetFirst()
 	{
 		return Stack.Num() > 0 ? &Stack[0] : nullptr;
@@ -401,53 +518,123 @@ struct PREDICTEDMOVEMENT_API FClientAuthStack
 		return Stack.Num() > 0 ? &Stack.Last() : nullptr;
 	}
 
+	const FClientAuthData* GetLatest() const
+	{
+		return Stack.Num() > 0 ? &Stack.Last() : nullptr;
+	}
+
 	void RemoveFirst()
 	{
 		if (Stack.Num() > 0)
 		{
 			Stack.RemoveAt(0);
+			OnStackChanged();
 		}
 	}
-	
-	const FClientAuthData* GetLatest() const
-	{
-		return Stack.Num() > 0 ? &Stack.Last() : nullptr;
-	}
 
 	void RemoveLatest()
 	{
 		if (Stack.Num() > 0)
 		{
 			Stack.RemoveAt(Stack.Num() - 1);
+			OnStackChanged();
 		}
 	}
 
 	void RemoveData(const FClientAuthData* Data)
 	{
-		if (Data)
+		if (Data && Stack.Remove(*Data) > 0)
 		{
-			Stack.Remove(*Data);
+			OnStackChanged();
 		}
 	}
 
 	void RemoveAllDataForSource(const FGameplayTag& Source)
 	{
-		Stack.RemoveAll([Source](const FClientAuthData& Data)
+		const int32 NumRemoved = Stack.RemoveAll([&Source](const FClientAuthData& Data)
 		{
 			return Data.Source == Source;
 		});
+
+		if (NumRemoved > 0)
+		{
+			OnStackChanged();
+		}
 	}
 
-	/**
-	 * Updates the time remaining for each client auth data in the stack
-	 * And removes any data that has expired (TimeRemaining <= 0)
-	 */
-	void Update(float DeltaTime)
+protected:
+	void RemoveExpired();
+
+	/** @return Averaged params of every entry with the specified priority */
+	FClientAuthParams CombineParams(int32 Priority) const;
+
+	/** Update NextExpiry and TopParams after the stack changes */
+	void OnStackChanged();
+};
+
+/** Modifier families replicated to simulated proxies by FSimulatedModifierLevels */
+enum class ESimulatedModifier : uint8
+{
+	Boost,
+	Snare,
+	SlowFall,
+	MAX
+};
+
+/**
+ * Every modifier level replicated to simulated proxies, packed into a single property so that a change to any number
+ * of them costs one property update
+ * Only active levels are sent, using only as many bits as the highest of them needs
+ */
+USTRUCT()
+struct PREDICTEDMOVEMENT_API FSimulatedModifierLevels
+{
+	GENERATED_BODY()
+
+	FSimulatedModifierLevels()
 	{
-		Stack.RemoveAll([DeltaTime](FClientAuthData& Data)
+		for (uint8& Level : Levels)
 		{
-			Data.TimeRemaining -= DeltaTime;
-			return Data.TimeRemaining <= 0.f;
-		});
+			Level = NO_MODIFIER;
+		}
 	}
+
+	/** Level index of each ESimulatedModifier, NO_MODIFIER if inactive */
+	UPROPERTY()
+	uint8 Levels[(uint8)ESimulatedModifier::MAX];
+
+	uint8 Get(ESimulatedModifier Modifier) const { return Levels[(uint8)Modifier]; }
+
+	/** @return True if the level changed */
+	bool Set(ESimulatedModifier Modifier, uint8 Level)
+	{
+		if (Levels[(uint8)Modifier] != Level)
+		{
+			Levels[(uint8)Modifier] = Level;
+			return true;
+		}
+		return false;
+	}
+
+	/** @return Bit mask of each ESimulatedModifier that differs from Other */
+	uint8 GetChangedMask(const FSimulatedModifierLevels& Other) const
+	{
+		uint8 Mask = 0;
+		for (uint8 i = 0; i < (uint8)ESimulatedModifier::MAX; ++i)
+		{
+			Mask |= (Levels[i] != Other.Levels[i]) ? (1 << i) : 0;
+		}
+		return Mask;
+	}
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSimulatedModifierLevels> : public TStructOpsTypeTraitsBase2<FSimulatedModifierLevels>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
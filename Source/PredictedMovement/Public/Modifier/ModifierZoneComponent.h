@@ -0,0 +1,46 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Components/BoxComponent.h"
+#include "ModifierZoneComponent.generated.h"
+
+/**
+ * Applies a Boost, Snare or SlowFall to any UModifierMovement inside the box, such as slow zones, speed pads and
+ * low gravity areas
+ *
+ * The box has no collision, it is registered with UModifierZoneSubsystem and evaluated by the movement component from
+ * its position each move, identically on client and server. The zone must exist on both, but needn't replicate.
+ */
+UCLASS(ClassGroup=(Movement), meta=(BlueprintSpawnableComponent))
+class PREDICTEDMOVEMENT_API UModifierZoneComponent : public UBoxComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Level applied while inside the zone, must be a Modifier.Boost, Modifier.Snare or Modifier.SlowFall level */
+	UPROPERTY(Category="Modifier Zone", EditAnywhere, BlueprintReadOnly, meta=(Categories="Modifier"))
+	FGameplayTag Level;
+
+public:
+	UModifierZoneComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+	/** Change the level applied by this zone, this must happen on both client and server */
+	UFUNCTION(BlueprintCallable, Category="Modifier Zone", meta=(Categories="Modifier"))
+	void SetLevel(FGameplayTag InLevel);
+
+protected:
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+
+	/** Add or update this zone within UModifierZoneSubsystem */
+	void RegisterZone();
+	void UnregisterZone();
+
+	/** Id within UModifierZoneSubsystem */
+	int32 ZoneId = INDEX_NONE;
+};
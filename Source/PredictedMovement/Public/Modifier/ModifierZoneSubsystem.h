@@ -0,0 +1,95 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ModifierZoneSubsystem.generated.h"
+
+class UModifierZoneComponent;
+
+/**
+ * A registered modifier zone, copied from UModifierZoneComponent so queries don't touch the component
+ */
+struct PREDICTEDMOVEMENT_API FModifierZone
+{
+	/** World to zone space */
+	FTransform InverseTransform;
+
+	/** Half size of the zone, in zone space */
+	FVector Extent = FVector::ZeroVector;
+
+	/** World space bounds, used to place the zone in the grid */
+	FBox Bounds = FBox(ForceInit);
+
+	/** Modifier.Boost, Modifier.Snare or Modifier.SlowFall */
+	FGameplayTag ModifierType;
+
+	/** Level applied while inside the zone */
+	FGameplayTag Level;
+
+	TWeakObjectPtr<UModifierZoneComponent> Component;
+
+	bool Contains(const FVector& Location) const
+	{
+		const FVector Local = InverseTransform.TransformPosition(Location);
+		return FMath::Abs(Local.X) <= Extent.X && FMath::Abs(Local.Y) <= Extent.Y && FMath::Abs(Local.Z) <= Extent.Z;
+	}
+};
+
+using TModifierZoneQuery = TArray<const FModifierZone*, TInlineAllocator<4>>;
+
+/**
+ * Stores modifier zones in a uniform grid, so that each UModifierMovement can find the zones it is inside with a
+ * single cell lookup per move instead of relying on overlap events
+ *
+ * Zones are evaluated from position by both client and server, so they require no replication and no corrections,
+ * but they must exist on both, e.g. placed in the level
+ */
+UCLASS()
+class PREDICTEDMOVEMENT_API UModifierZoneSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Add or update a zone, called by UModifierZoneComponent when registered or moved
+	 * @param ZoneId Id returned by a previous call to update that zone, or INDEX_NONE to add a new zone
+	 * @return Id of the zone
+	 */
+	int32 RegisterZone(int32 ZoneId, const FModifierZone& Zone);
+
+	/** Remove a zone added by RegisterZone() */
+	void UnregisterZone(int32 ZoneId);
+
+	/**
+	 * Find every zone that contains Location
+	 * @param OutZones Reset and filled with the zones
+	 */
+	void GetZonesAtLocation(const FVector& Location, TModifierZoneQuery& OutZones) const;
+
+	/** Size of each grid cell, zones are added to every cell their bounds touch */
+	float GetCellSize() const { return CellSize; }
+
+	/** Change the size of each grid cell, re-adding every zone */
+	void SetCellSize(float InCellSize);
+
+	int32 GetNumZones() const { return Zones.Num(); }
+
+protected:
+	FIntVector GetCell(const FVector& Location) const;
+
+	void AddToCells(int32 ZoneId);
+	void RemoveFromCells(int32 ZoneId);
+
+	/** Every registered zone, indexed by zone id */
+	TSparseArray<FModifierZone> Zones;
+
+	/** Zone ids that overlap each cell */
+	TMap<FIntVector, TArray<int32, TInlineAllocator<2>>> Cells;
+
+	float CellSize = 2000.f;
+};
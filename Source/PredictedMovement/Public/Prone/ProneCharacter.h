@@ -27,6 +27,17 @@ public:
 	float PronedEyeHeight;
 	
 protected:
+	/** Mesh relative Z of the class default, cached by CacheStanceDefaults() */
+	float DefaultMeshRelativeZ;
+
+	/** BaseTranslationOffset Z of the class default, cached by CacheStanceDefaults() */
+	float DefaultBaseTranslationOffsetZ;
+
+	/** True if the class default has a mesh */
+	uint8 bDefaultHasMesh:1;
+
+	uint8 bStanceDefaultsCached:1;
+
 	/** Set by character movement to specify that this Character is currently Proned. */
 	UPROPERTY(BlueprintReadOnly, replicatedUsing=OnRep_IsProned, Category=Character)
 	uint8 bIsProned:1;
@@ -36,6 +47,11 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	virtual void PostInitializeComponents() override;
+
+	/** Cache the default mesh offsets of this class, so stance changes don't read the class default object */
+	void CacheStanceDefaults();
+
 public:
 	virtual void RecalculateBaseEyeHeight() override;
 	
@@ -4,9 +4,71 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Prone/StanceTypes.h"
 #include "ProneMovement.generated.h"
 
 class AProneCharacter;
+
+/**
+ * Result of the last blocked attempt to change into a stance
+ * Reused until the character moves beyond a threshold, changes base or floor, or the retry interval passes
+ * Keyed on the predicted timestamp so that client and server expire it on the same move
+ */
+struct PREDICTEDMOVEMENT_API FProneEncroachmentCache
+{
+	FProneEncroachmentCache()
+		: Location(FVector::ZeroVector)
+		, Timestamp(-1.f)
+		, bBlocked(false)
+	{}
+
+	/** Capsule location of the blocked attempt */
+	FVector Location;
+
+	/** Movement base of the blocked attempt */
+	TWeakObjectPtr<const UPrimitiveComponent> Base;
+
+	/** Floor of the blocked attempt */
+	TWeakObjectPtr<const UPrimitiveComponent> Floor;
+
+	/** Predicted timestamp of the blocked attempt */
+	float Timestamp;
+
+	uint8 bBlocked:1;
+
+	/** @return True if an attempt with these keys is known to be blocked */
+	bool IsBlocked(const FVector& InLocation, const UPrimitiveComponent* InBase, const UPrimitiveComponent* InFloor,
+		float InTimestamp, float RetryDistance, float RetryInterval) const
+	{
+		// Timestamps reset periodically, which also expires the cache
+		return bBlocked && InTimestamp >= Timestamp && InTimestamp - Timestamp < RetryInterval &&
+			Base.Get() == InBase && Floor.Get() == InFloor &&
+			FVector::DistSquared(Location, InLocation) < FMath::Square(RetryDistance);
+	}
+
+	void SetBlocked(const FVector& InLocation, const UPrimitiveComponent* InBase, const UPrimitiveComponent* InFloor,
+		float InTimestamp)
+	{
+		Location = InLocation;
+		Base = InBase;
+		Floor = InFloor;
+		Timestamp = InTimestamp;
+		bBlocked = true;
+	}
+
+	void Invalidate()
+	{
+		bBlocked = false;
+	}
+};
+
+/**
+ * Prone shell, also responsible for crouching so that every stance shares a single transition path
+ *
+ * Each stance is built from the properties below and the default capsule, which is cached so that transitions don't
+ * read the class default object. Changing directly between any two stances, e.g. Prone ➜ Crouch,
+ * resolves with a single clearance query against the target capsule rather than a query per intermediate stance.
+ */
 UCLASS()
 class PREDICTEDMOVEMENT_API UProneMovement : public UCharacterMovementComponent
 {
@@ -69,6 +131,20 @@ public:
 	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", ForceUnits=cm))
 	float ProneLockDuration;
 	
+	/**
+	 * When a stance change is blocked by geometry, don't test again until the character has moved this far
+	 * or EncroachmentRetryInterval has passed
+	 */
+	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", ForceUnits=cm))
+	float EncroachmentRetryDistance;
+
+	/**
+	 * When a stance change is blocked by geometry, don't test again for this duration unless the character has
+	 * moved EncroachmentRetryDistance. 0 tests every update.
+	 */
+	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", ForceUnits=s))
+	float EncroachmentRetryInterval;
+
 	/** If true, Character can walk off a ledge when proned. */
 	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite)
 	uint8 bCanWalkOffLedgesWhenProned:1;
@@ -84,6 +160,23 @@ public:
 protected:
 	float ProneLockTimestamp = -1.f;
 
+	/** Timestamp of the saved move being replayed, so GetTimestamp() matches the server during replays */
+	float ReplayingMoveTimestamp = -1.f;
+
+	/** Last blocked attempt to change into each stance */
+	FProneEncroachmentCache EncroachmentCache[(uint8)EPredictedStance::MAX];
+
+	/**
+	 * Default capsule and eye height of the owner's class, cached by RefreshStanceTable()
+	 * Every other stance is derived from this and the live stance properties in GetStanceParams()
+	 */
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, Transient)
+	FStanceParams DefaultStanceParams;
+
+	/** Stance the capsule currently represents */
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, Transient)
+	EPredictedStance CapsuleStance;
+
 public:
 	UProneMovement(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	
@@ -115,9 +208,66 @@ public:
 
 	float GetTimestamp() const;
 
+	/** @return True if the last attempt was blocked and nothing relevant has changed since */
+	bool IsEncroachmentCached(const FProneEncroachmentCache& Cache) const;
+
+	/** Record a blocked attempt */
+	void CacheEncroachment(FProneEncroachmentCache& Cache) const;
+
+	/** Discard blocked attempts, they will be tested again on the next attempt */
+	void InvalidateEncroachmentCache();
+
+public:
+	/**
+	 * Cache the default capsule and eye height from the owner's class default object
+	 * Only needs calling again if the class default object changes, stance properties are read when used
+	 */
+	UFUNCTION(BlueprintCallable, Category="Character Movement")
+	void RefreshStanceTable();
+
+	/** @return Collision, eye height and speeds of Stance, from the cached default capsule and the current properties */
+	FStanceParams GetStanceParams(EPredictedStance Stance) const;
+
+	/** @return Stance the capsule currently represents */
+	UFUNCTION(BlueprintPure, Category="Character Movement")
+	EPredictedStance GetStance() const { return CapsuleStance; }
+
+	/** @return Stance represented by the replicated bIsCrouched and bIsProned */
+	EPredictedStance GetReplicatedStance() const;
+
+	/** @return Stance to change to based on bWantsToCrouch and bWantsToProne */
+	virtual EPredictedStance GetDesiredStance() const;
+
+	/**
+	 * Change the capsule directly from the current stance to NewStance, shared by Crouch, UnCrouch, Prone and UnProne
+	 * A taller capsule is tested once against the final shape, regardless of any stances in between
+	 * @param	bClientSimulation	true when called when the stance is replicated to non owned clients.
+	 * @return True if the capsule now represents NewStance
+	 */
+	virtual bool ChangeStance(EPredictedStance NewStance, bool bClientSimulation = false);
+
+protected:
+	/**
+	 * Find room for a capsule growing into Stance, moving the character if required
+	 * @return True if the capsule fits
+	 */
+	virtual bool MoveToFitStance(const FStanceParams& Stance);
+
+	/** Size of a simulated proxy capsule for Stance, shrunk by NetProxyShrinkRadius and NetProxyShrinkHalfHeight */
+	void GetProxyCapsuleSize(const FStanceParams& Stance, float& OutRadius, float& OutHalfHeight) const;
+
+	/** Set bIsCrouched and bIsProned on the owner to represent Stance */
+	virtual void SetStanceFlags(EPredictedStance Stance);
+
+	/** Call the end event of PrevStance then the start event of NewStance on the owner */
+	virtual void NotifyStanceChanged(EPredictedStance PrevStance, EPredictedStance NewStance);
+
 public:
 	virtual bool IsProned() const;
 
+	virtual void Crouch(bool bClientSimulation = false) override;
+	virtual void UnCrouch(bool bClientSimulation = false) override;
+
 	/**
 	 * Call CharacterOwner->OnStartProne() if successful.
 	 * In general you should set bWantsToProne instead to have the Prone persist during movement, or just use the Prone functions on the owning Character.
@@ -126,7 +276,7 @@ public:
 	virtual void Prone(bool bClientSimulation = false);
 	
 	/**
-	 * Checks if default capsule size fits (no encroachment), and trigger OnEndProne() on the owner if successful.
+	 * Checks if the standing, or crouched if bWantsToCrouch, capsule size fits (no encroachment), and trigger OnEndProne() on the owner if successful.
 	 * @param	bClientSimulation	true when called when bIsProned is replicated to non owned clients.
 	 */
 	virtual void UnProne(bool bClientSimulation = false);
@@ -140,6 +290,8 @@ public:
 protected:
 	virtual bool ClientUpdatePositionAfterServerUpdate() override;
 
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
 	
 public:
@@ -0,0 +1,64 @@
+﻿// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StanceTypes.generated.h"
+
+/**
+ * Capsule stances handled by UProneMovement, ordered from tallest to shortest
+ * Adding a stance requires a case in UProneMovement::GetStanceParams() and its start/end events, transitions to and
+ * from it resolve through the same single clearance query as every other stance
+ */
+UENUM(BlueprintType)
+enum class EPredictedStance : uint8
+{
+	Stand,
+	Crouch,
+	Prone,
+	MAX			UMETA(Hidden)
+};
+
+/** Collision, eye height and movement properties for a single stance */
+USTRUCT(BlueprintType)
+struct PREDICTEDMOVEMENT_API FStanceParams
+{
+	GENERATED_BODY()
+
+	FStanceParams()
+		: Radius(34.f)
+		, HalfHeight(88.f)
+		, EyeHeight(64.f)
+		, MaxWalkSpeed(600.f)
+		, MaxAcceleration(2048.f)
+		, BrakingDeceleration(2048.f)
+		, GroundFriction(8.f)
+		, BrakingFriction(0.f)
+	{}
+
+	/** Unscaled capsule radius */
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, BlueprintReadOnly, meta=(ForceUnits=cm))
+	float Radius;
+
+	/** Unscaled capsule half-height, never smaller than Radius */
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, BlueprintReadOnly, meta=(ForceUnits=cm))
+	float HalfHeight;
+
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, BlueprintReadOnly, meta=(ForceUnits=cm))
+	float EyeHeight;
+
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, BlueprintReadOnly, meta=(ForceUnits="cm/s"))
+	float MaxWalkSpeed;
+
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, BlueprintReadOnly)
+	float MaxAcceleration;
+
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, BlueprintReadOnly)
+	float BrakingDeceleration;
+
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, BlueprintReadOnly)
+	float GroundFriction;
+
+	UPROPERTY(Category="Character Movement: Stance", VisibleInstanceOnly, BlueprintReadOnly)
+	float BrakingFriction;
+};
@@ -7,6 +7,42 @@
 #include "SprintMovement.generated.h"
 
 class ASprintCharacter;
+
+/**
+ * Sprint state evaluated at most once per substep
+ * Reused by every getter until the velocity, acceleration, rotation or sprint state changes
+ */
+struct PREDICTEDMOVEMENT_API FSprintSnapshot
+{
+	FSprintSnapshot()
+		: Velocity(FVector::ZeroVector)
+		, Acceleration(FVector::ZeroVector)
+		, Rotation(FQuat::Identity)
+		, bValid(false)
+		, bIsSprinting(false)
+		, bHasSprintingAtSpeed(false)
+		, bIsSprintingAtSpeed(false)
+		, bHasInputAngle(false)
+		, bIsWithinAllowableInputAngle(false)
+	{}
+
+	/** Velocity the snapshot was taken with */
+	FVector Velocity;
+
+	/** Acceleration the snapshot was taken with */
+	FVector Acceleration;
+
+	/** Rotation the input angle was evaluated with */
+	FQuat Rotation;
+
+	uint8 bValid:1;
+	uint8 bIsSprinting:1;
+	uint8 bHasSprintingAtSpeed:1;
+	uint8 bIsSprintingAtSpeed:1;
+	uint8 bHasInputAngle:1;
+	uint8 bIsWithinAllowableInputAngle:1;
+};
+
 UCLASS()
 class PREDICTEDMOVEMENT_API USprintMovement : public UCharacterMovementComponent
 {
@@ -93,6 +129,31 @@ public:
 	virtual void OnRegister() override;
 	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
 
+protected:
+	/** Sprint state for the current substep, read through GetSprintSnapshot() */
+	mutable FSprintSnapshot SprintSnapshot;
+
+public:
+	/** @return Sprint state for the current substep, refreshed if velocity or acceleration changed since it was taken */
+	const FSprintSnapshot& GetSprintSnapshot() const;
+
+	/**
+	 * Discard the sprint snapshot, it will be rebuilt by the next query
+	 * Call this if you change properties that affect sprinting outside of movement, e.g. MaxWalkSpeed
+	 */
+	void InvalidateSprintSnapshot() const { SprintSnapshot.bValid = false; }
+
+	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+	virtual void Crouch(bool bClientSimulation = false) override;
+	virtual void UnCrouch(bool bClientSimulation = false) override;
+
+protected:
+	/** Evaluates IsSprintingAtSpeed() for the snapshot, avoid calling directly */
+	virtual bool CalcIsSprintingAtSpeed() const;
+
+	/** Evaluates IsSprintWithinAllowableInputAngle() for the snapshot, avoid calling directly */
+	virtual bool CalcIsSprintWithinAllowableInputAngle() const;
+
 public:
 	virtual bool IsSprintingAtSpeed() const;
 	virtual bool IsSprintingInEffect() const { return IsSprintingAtSpeed() && IsSprintWithinAllowableInputAngle(); }
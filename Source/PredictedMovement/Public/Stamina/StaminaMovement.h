@@ -4,9 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "System/AdaptiveCorrection.h"
 #include "System/PredictedMovementVersioning.h"
 #include "StaminaMovement.generated.h"
 
+class AController;
+
 struct PREDICTEDMOVEMENT_API FStaminaMoveResponseDataContainer : FCharacterMoveResponseDataContainer
 {  // Server ➜ Client
 	using Super = FCharacterMoveResponseDataContainer;
@@ -88,10 +91,19 @@ public:
 	/** Maximum stamina difference that is allowed between client and server before a correction occurs. */
 	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly, meta=(ClampMin="0.0", UIMin="0.0"))
 	float NetworkStaminaCorrectionThreshold;
+
+	/**
+	 * Optionally widen or tighten NetworkStaminaCorrectionThreshold per connection based on the stamina error
+	 * measured from that connection. Server only.
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly)
+	FAdaptiveCorrectionParams AdaptiveStaminaCorrection;
 	
 public:
 	UStaminaMovement(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
+
 protected:
 	/** THIS SHOULD ONLY BE MODIFIED IN DERIVED CLASSES FROM OnStaminaChanged AND NOWHERE ELSE */
 	UPROPERTY()
@@ -115,6 +127,16 @@ public:
 
 	void SetStaminaDrained(bool bNewValue);
 
+	/** @return NetworkStaminaCorrectionThreshold scaled for this connection by AdaptiveStaminaCorrection */
+	UFUNCTION(BlueprintPure, Category="Character Movement (Networking)")
+	float GetNetworkStaminaCorrectionThreshold() const
+	{
+		return NetworkStaminaCorrectionThreshold * AdaptiveStaminaCorrectionState.GetScale(AdaptiveStaminaCorrection);
+	}
+
+	/** @return Measured stamina error statistics for this connection, only populated on the server */
+	const FAdaptiveCorrectionState& GetAdaptiveStaminaCorrectionState() const { return AdaptiveStaminaCorrectionState; }
+
 protected:
 	/*
 	 * Drain state entry and exit is handled here. Drain state is used to prevent rapid re-entry of sprinting or other
@@ -127,6 +149,13 @@ protected:
 	virtual void OnStaminaDrained() {}
 	virtual void OnStaminaDrainRecovered() {}
 
+	/** The measured error belongs to the previous connection, start over */
+	UFUNCTION()
+	virtual void OnPawnControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+private:
+	FAdaptiveCorrectionState AdaptiveStaminaCorrectionState;
+
 private:
 	FStaminaMoveResponseDataContainer StaminaMoveResponseDataContainer;
 
@@ -7,6 +7,10 @@
 #include "StrafeMovement.generated.h"
 
 class AStrafeCharacter;
+class UCurveFloat;
+
+/** Number of samples in the baked strafe speed table, odd so that lateral movement has its own sample */
+static constexpr int32 StrafeSpeedTableSize = 33;
 
 /**
  * Strafe is a shell intended for changing to and from a strafing state, however the actual implementation of
@@ -65,7 +69,38 @@ public:
 	 */
 	UPROPERTY(Category="Character Movement (General Settings)", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", EditCondition="bUseSeparateBrakingFriction"))
 	float BrakingFrictionStrafing;
-	
+
+	/**
+	 * If true, MaxWalkSpeedStrafing is scaled by the direction of movement relative to facing
+	 * Call BakeStrafeSpeedTable() after changing the directional properties at runtime
+	 */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite)
+	uint8 bUseDirectionalStrafeSpeed:1;
+
+	/** MaxWalkSpeedStrafing multiplier when moving forward */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", EditCondition="bUseDirectionalStrafeSpeed"))
+	float StrafeSpeedForwardMultiplier;
+
+	/** MaxWalkSpeedStrafing multiplier when moving sideways */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", EditCondition="bUseDirectionalStrafeSpeed"))
+	float StrafeSpeedLateralMultiplier;
+
+	/** MaxWalkSpeedStrafing multiplier when moving backward */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", EditCondition="bUseDirectionalStrafeSpeed"))
+	float StrafeSpeedBackwardMultiplier;
+
+	/**
+	 * Optional MaxWalkSpeedStrafing multiplier by direction, overrides the forward, lateral and backward multipliers
+	 * X is the dot product of the movement direction and facing, -1 is backward, 0 is lateral, 1 is forward
+	 * Baked into a table on load, the curve is never evaluated during movement
+	 */
+	UPROPERTY(Category="Character Movement: Walking", EditAnywhere, BlueprintReadWrite, meta=(EditCondition="bUseDirectionalStrafeSpeed"))
+	TObjectPtr<UCurveFloat> StrafeSpeedCurve;
+
+protected:
+	/** MaxWalkSpeedStrafing multiplier sampled uniformly from backward (-1) to forward (1) */
+	float StrafeSpeedTable[StrafeSpeedTableSize];
+
 public:
 	/** If true, try to Strafe (or keep Strafing) on next update. If false, try to stop Strafing on next update. */
 	UPROPERTY(Category="Character Movement (General Settings)", VisibleInstanceOnly, BlueprintReadOnly)
@@ -78,6 +113,20 @@ public:
 	virtual void PostLoad() override;
 	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Sample the directional multipliers or StrafeSpeedCurve into StrafeSpeedTable */
+	UFUNCTION(BlueprintCallable, Category="Character Movement")
+	void BakeStrafeSpeedTable();
+
+	/**
+	 * MaxWalkSpeedStrafing multiplier for the current direction of movement relative to facing
+	 * Uses acceleration (input) when available, otherwise velocity, so client and server agree on the same move
+	 */
+	float GetStrafeSpeedMultiplier() const;
+
 public:
 	virtual float GetMaxAcceleration() const override;
 	virtual float GetMaxSpeed() const override;
@@ -0,0 +1,105 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AdaptiveCorrection.generated.h"
+
+/**
+ * Configuration for a server-side controller that widens or tightens a correction threshold per connection
+ * based on the error it has recently measured from that connection
+ *
+ * Players on poor connections produce larger and noisier errors, a fixed threshold causes correction storms for them,
+ * while LAN players rarely come close to the threshold and can be held to a tighter one
+ */
+USTRUCT(BlueprintType)
+struct PREDICTEDMOVEMENT_API FAdaptiveCorrectionParams
+{
+	GENERATED_BODY()
+
+	FAdaptiveCorrectionParams()
+		: bEnabled(false)
+		, MinScale(0.5f)
+		, MaxScale(2.f)
+		, SampleWindow(2.f)
+		, ErrorDeviations(2.f)
+		, TargetCorrectionRate(1.f)
+		, ScaleInterpSpeed(0.5f)
+	{}
+
+	/** If true, the threshold is scaled per connection, otherwise the authored threshold is always used */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly)
+	bool bEnabled;
+
+	/** The threshold will never be scaled below this amount */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly, meta=(ClampMin="0.01", UIMin="0.01", ForceUnits="x", EditCondition="bEnabled", EditConditionHides))
+	float MinScale;
+
+	/** The threshold will never be scaled above this amount */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly, meta=(ClampMin="0.01", UIMin="0.01", ForceUnits="x", EditCondition="bEnabled", EditConditionHides))
+	float MaxScale;
+
+	/**
+	 * Time constant of the error statistics, older samples decay with this window
+	 * Shorter windows react faster to a connection degrading, but are noisier
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly, meta=(ClampMin="0.01", UIMin="0.01", ForceUnits="s", EditCondition="bEnabled", EditConditionHides))
+	float SampleWindow;
+
+	/**
+	 * The threshold is chosen to cover the mean error plus this many standard deviations of it
+	 * Higher values tolerate more jitter before correcting
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly, meta=(ClampMin="0", UIMin="0", EditCondition="bEnabled", EditConditionHides))
+	float ErrorDeviations;
+
+	/**
+	 * Corrections per second this connection is allowed before the threshold is widened further
+	 * 0 disables widening based on correction rate
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly, meta=(ClampMin="0", UIMin="0", EditCondition="bEnabled", EditConditionHides))
+	float TargetCorrectionRate;
+
+	/** How quickly the scale can change, per second, prevents oscillation between wide and tight thresholds */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly, meta=(ClampMin="0", UIMin="0", ForceUnits="x", EditCondition="bEnabled", EditConditionHides))
+	float ScaleInterpSpeed;
+};
+
+/**
+ * Per connection state for FAdaptiveCorrectionParams
+ * Only sampled on the server, from ServerMoveHandleClientError/ServerCheckClientError, so it is never predicted
+ */
+struct PREDICTEDMOVEMENT_API FAdaptiveCorrectionState
+{
+	/** Exponentially weighted mean of the normalized error */
+	float ErrorMean = 0.f;
+
+	/** Exponentially weighted variance of the normalized error */
+	float ErrorVariance = 0.f;
+
+	/** Exponentially weighted corrections per second */
+	float CorrectionRate = 0.f;
+
+	/** Current scale applied to the authored threshold */
+	float Scale = 1.f;
+
+	void Reset()
+	{
+		*this = FAdaptiveCorrectionState();
+	}
+
+	/**
+	 * Add an error sample from a single client move
+	 * @param Params Controller configuration
+	 * @param NormalizedError Error divided by the authored (un-scaled) threshold, 1.0 is exactly on the authored threshold
+	 * @param bCorrected True if this move resulted in a correction
+	 * @param DeltaTime Duration of the client move
+	 */
+	void AddSample(const FAdaptiveCorrectionParams& Params, float NormalizedError, bool bCorrected, float DeltaTime);
+
+	/** @return Scale to apply to the authored threshold */
+	float GetScale(const FAdaptiveCorrectionParams& Params) const
+	{
+		return Params.bEnabled ? Scale : 1.f;
+	}
+};
@@ -0,0 +1,179 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+/**
+ * Bits within FPredictedInputFlags, obtained from FPredictedInputFlagRegistry
+ * Offset is INDEX_NONE until the registry is finalized
+ */
+struct PREDICTEDMOVEMENT_API FPredictedInputFlag
+{
+	FPredictedInputFlag()
+		: Offset(INDEX_NONE)
+		, NumBits(0)
+	{}
+
+	FPredictedInputFlag(int32 InOffset, int32 InNumBits)
+		: Offset(InOffset)
+		, NumBits(InNumBits)
+	{}
+
+	int32 Offset;
+	int32 NumBits;
+
+	bool IsValid() const { return Offset != INDEX_NONE && NumBits > 0; }
+
+	/** @return Mask of the bits this flag occupies, right aligned */
+	uint32 GetValueMask() const { return NumBits >= 32 ? MAX_uint32 : (1u << NumBits) - 1u; }
+
+	/** @return Mask of the bits this flag occupies within FPredictedInputFlags */
+	uint32 GetMask() const { return IsValid() ? GetValueMask() << Offset : 0; }
+};
+
+/**
+ * Extended input bits sent client ➜ server, beyond the four FLAG_Custom compressed flags
+ * Serialized as a single varint, so a handful of flags cost a single byte
+ */
+struct PREDICTEDMOVEMENT_API FPredictedInputFlags
+{
+	FPredictedInputFlags()
+		: Bits(0)
+	{}
+
+	uint32 Bits;
+
+	bool Get(const FPredictedInputFlag& Flag) const
+	{
+		return (Bits & Flag.GetMask()) != 0;
+	}
+
+	void Set(const FPredictedInputFlag& Flag, bool bValue)
+	{
+		SetValue(Flag, bValue ? 1 : 0);
+	}
+
+	uint32 GetValue(const FPredictedInputFlag& Flag) const
+	{
+		checkSlow(Flag.IsValid());
+		return Flag.IsValid() ? (Bits >> Flag.Offset) & Flag.GetValueMask() : 0;
+	}
+
+	void SetValue(const FPredictedInputFlag& Flag, uint32 Value)
+	{
+		checkSlow(Flag.IsValid());
+		checkSlow(Value <= Flag.GetValueMask());
+		Bits = (Bits & ~Flag.GetMask()) | ((Value & Flag.GetValueMask()) << Flag.Offset);
+	}
+
+	void Reset() { Bits = 0; }
+
+	void Serialize(FArchive& Ar) { SerializeBits(Ar, Bits); }
+
+	/** Shared by every move data that sends packed input bits */
+	static void SerializeBits(FArchive& Ar, uint32& InBits) { Ar.SerializeIntPacked(InBits); }
+
+	bool operator==(const FPredictedInputFlags& Other) const { return Bits == Other.Bits; }
+	bool operator!=(const FPredictedInputFlags& Other) const { return Bits != Other.Bits; }
+};
+
+/**
+ * Hands out bits within FPredictedInputFlags so that shells can combine without colliding
+ *
+ * Reserve() assigns fixed bits immediately and is checked for collision against every other flag.
+ * Allocate() requests a number of bits, the offset is assigned when the registry is finalized, sorted by name so that
+ * client and server agree regardless of module load or static initialization order.
+ *
+ * Register flags from a static initializer or StartupModule, the registry is finalized after engine init.
+ */
+class PREDICTEDMOVEMENT_API FPredictedInputFlagRegistry
+{
+public:
+	static FPredictedInputFlagRegistry& Get();
+
+	/**
+	 * Reserve fixed bits, for flags that must be stable
+	 * @return Flag, valid immediately
+	 */
+	const FPredictedInputFlag& Reserve(FName Name, int32 Offset, int32 NumBits);
+
+	/**
+	 * Request bits to be assigned when the registry is finalized
+	 * @return Flag, valid once IsFinalized()
+	 */
+	const FPredictedInputFlag& Allocate(FName Name, int32 NumBits);
+
+	/** Assign offsets to every allocated flag, further allocations are not allowed */
+	void Finalize();
+
+	bool IsFinalized() const { return bFinalized; }
+
+	/** @return Flag registered with this name, or nullptr */
+	const FPredictedInputFlag* Find(FName Name) const;
+
+	/** @return Every bit that has been reserved or assigned */
+	uint32 GetUsedMask() const { return UsedMask; }
+
+private:
+	void ClaimBits(FName Name, const FPredictedInputFlag& Flag);
+
+	/** Flags are heap allocated so references returned by Reserve/Allocate remain valid */
+	TMap<FName, TUniquePtr<FPredictedInputFlag>> Flags;
+
+	/** Allocated flags that have not been assigned an offset */
+	TArray<FName> PendingAllocations;
+
+	uint32 UsedMask = 0;
+	bool bFinalized = false;
+};
+
+/**
+ * Saved move that carries FPredictedInputFlags, derive from this instead of FSavedMove_Character and fill InputFlags
+ * from SetMoveFor, then restore them from PrepMoveFor
+ */
+class PREDICTEDMOVEMENT_API FSavedMove_Character_PredictedInput : public FSavedMove_Character
+{
+	using Super = FSavedMove_Character;
+
+public:
+	virtual ~FSavedMove_Character_PredictedInput() override
+	{}
+
+	FPredictedInputFlags InputFlags;
+
+	/** Clear saved move properties, so it can be re-used. */
+	virtual void Clear() override;
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+};
+
+/**
+ * Network move data that sends FPredictedInputFlags, derive from this instead of FCharacterNetworkMoveData
+ * Requires a saved move derived from FSavedMove_Character_PredictedInput
+ */
+struct PREDICTEDMOVEMENT_API FPredictedInputNetworkMoveData : FCharacterNetworkMoveData
+{  // Client ➜ Server
+	using Super = FCharacterNetworkMoveData;
+
+	FPredictedInputFlags InputFlags;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+};
+
+struct PREDICTEDMOVEMENT_API FPredictedInputNetworkMoveDataContainer : FCharacterNetworkMoveDataContainer
+{  // Client ➜ Server
+	using Super = FCharacterNetworkMoveDataContainer;
+
+	FPredictedInputNetworkMoveDataContainer()
+	{
+		NewMoveData = &MoveData[0];
+		PendingMoveData = &MoveData[1];
+		OldMoveData = &MoveData[2];
+	}
+
+private:
+	FPredictedInputNetworkMoveData MoveData[3];
+};
@@ -0,0 +1,614 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Templates/Tuple.h"
+#include "System/PredictedInputFlags.h"
+#include "PredictedMovementComposition.generated.h"
+
+/**
+ * Base for features that are composed into a single movement component by TPredictedFeatureSet
+ *
+ * Each shell is a separate component with its own saved move, prediction data and move containers. Combining them by
+ * hand results in a deep chain of Super:: calls through every getter. Features are instead plain structs with hooks
+ * that are resolved at compile time. A derived feature hides only the hooks it needs, and the composed component folds
+ * every feature into a single virtual call.
+ *
+ * Sprint, Strafe and Stamina are available as features (FSprintFeature, FStrafeFeature, FStaminaFeature).
+ * Prone and Modifier are not, their capsule changes and modifier stacks don't fit these hooks, use their own shells.
+ *
+ * Hooks are intentionally non-virtual, do not add virtual functions to features.
+ * Features are evaluated in the order they are declared in the feature set, later features take precedence in the
+ * same way a derived class would when calling Super:: first.
+ *
+ * @see UComposedMovement for an example composition
+ */
+USTRUCT()
+struct PREDICTEDMOVEMENT_API FPredictedMovementFeature
+{
+	GENERATED_BODY()
+
+	/** Number of input bits sent client ➜ server, packed with every other feature into a single field */
+	static constexpr int32 NumInputBits = 0;
+
+	/** Number of state bits replicated to simulated proxies, packed with every other feature into a single field */
+	static constexpr int32 NumStateBits = 0;
+
+	/** Saved move state, for anything that must be restored or compared when combining moves */
+	struct FSavedState
+	{
+		void Clear() {}
+		template<typename TFeature> void SetInitialPosition(const TFeature& Feature) {}
+		template<typename TFeature> void PostUpdate(const TFeature& Feature, bool& bForceNoCombine) {}
+
+		/** Called on the old move, restore the feature to the start of the old move */
+		template<typename TFeature> void CombineWith(TFeature& Feature) const {}
+		bool CanCombineWith(const FSavedState& NewMove) const { return true; }
+	};
+
+	/** Client ➜ Server data beyond the packed input bits */
+	struct FMoveData
+	{
+		template<typename TSavedState> void Fill(const TSavedState& SavedState) {}
+		void Serialize(FArchive& Ar) {}
+	};
+
+	/** Server ➜ Client data, only sent with corrections */
+	struct FResponseData
+	{
+		template<typename TFeature> void Fill(const TFeature& Feature) {}
+		void Serialize(FArchive& Ar) {}
+		template<typename TFeature> void Apply(TFeature& Feature) const {}
+	};
+
+	void Initialize(UCharacterMovementComponent& MoveComp) {}
+
+	/** @return Input bits, right aligned, NumInputBits wide */
+	uint32 GetInputBits() const { return 0; }
+	void SetInputBits(uint32 Bits) {}
+
+	/** @return State bits, right aligned, NumStateBits wide */
+	uint32 GetStateBits() const { return 0; }
+	void SetSimulatedStateBits(UCharacterMovementComponent& MoveComp, uint32 Bits) {}
+
+	void ModifyMaxSpeed(const UCharacterMovementComponent& MoveComp, float& MaxSpeed) const {}
+	void ModifyMaxAcceleration(const UCharacterMovementComponent& MoveComp, float& MaxAcceleration) const {}
+	void ModifyMaxBrakingDeceleration(const UCharacterMovementComponent& MoveComp, float& MaxBrakingDeceleration) const {}
+	void ModifyGroundFriction(const UCharacterMovementComponent& MoveComp, float& Friction) const {}
+	void ModifyBrakingFriction(const UCharacterMovementComponent& MoveComp, float& Friction) const {}
+
+	/** Called from CalcVelocity before Super, within the physics substeps */
+	void CalcVelocity(UCharacterMovementComponent& MoveComp, float DeltaTime) {}
+
+	/** Not called on simulated proxies, they receive state bits instead */
+	void UpdateBeforeMovement(UCharacterMovementComponent& MoveComp, float DeltaSeconds) {}
+	void UpdateAfterMovement(UCharacterMovementComponent& MoveComp, float DeltaSeconds) {}
+
+	/** @return True if the client's move data differs enough from the server to require a correction */
+	template<typename TMoveData> bool ServerCheckClientError(const TMoveData& MoveData) const { return false; }
+};
+
+/**
+ * Compile-time set of features that a composed movement component folds together
+ * The component is expected to declare `using FFeatureSet = TPredictedFeatureSet<...>` and provide
+ * `FFeatureSet::FRefs GetFeatures()` and `FFeatureSet::FConstRefs GetFeatures() const`
+ */
+template<typename... TFeatures>
+struct TPredictedFeatureSet
+{
+	static constexpr uint32 NumFeatures = sizeof...(TFeatures);
+	static constexpr int32 NumInputBits = (0 + ... + TFeatures::NumInputBits);
+	static constexpr int32 NumStateBits = (0 + ... + TFeatures::NumStateBits);
+
+	static_assert(NumFeatures > 0, "TPredictedFeatureSet requires at least one feature");
+	static_assert(NumInputBits <= 32, "Features exceed the 32 packed input bits");
+	static_assert(NumStateBits <= 32, "Features exceed the 32 packed state bits");
+
+	using FRefs = TTuple<TFeatures&...>;
+	using FConstRefs = TTuple<const TFeatures&...>;
+	using FSavedStates = TTuple<typename TFeatures::FSavedState...>;
+	using FMoveData = TTuple<typename TFeatures::FMoveData...>;
+	using FResponseData = TTuple<typename TFeatures::FResponseData...>;
+
+	template<uint32 Index>
+	using TFeature = typename TTupleElement<Index, TTuple<TFeatures...>>::Type;
+
+	static constexpr uint32 MakeMask(int32 NumBits)
+	{
+		return NumBits >= 32 ? MAX_uint32 : (1u << NumBits) - 1u;
+	}
+
+	/** @return Offset of the feature's input bits within the packed field */
+	template<uint32 Index>
+	static constexpr int32 GetInputBitOffset()
+	{
+		constexpr int32 Sizes[] = { TFeatures::NumInputBits..., 0 };
+		int32 Offset = 0;
+		for (uint32 i = 0; i < Index; i++)
+		{
+			Offset += Sizes[i];
+		}
+		return Offset;
+	}
+
+	/** @return Offset of the feature's state bits within the packed field */
+	template<uint32 Index>
+	static constexpr int32 GetStateBitOffset()
+	{
+		constexpr int32 Sizes[] = { TFeatures::NumStateBits..., 0 };
+		int32 Offset = 0;
+		for (uint32 i = 0; i < Index; i++)
+		{
+			Offset += Sizes[i];
+		}
+		return Offset;
+	}
+
+	static uint32 PackInputBits(const FConstRefs& Features)
+	{
+		return PackInputBits(Features, TMakeIntegerSequence<uint32, NumFeatures>());
+	}
+
+	static void UnpackInputBits(const FRefs& Features, uint32 Bits)
+	{
+		UnpackInputBits(Features, Bits, TMakeIntegerSequence<uint32, NumFeatures>());
+	}
+
+	static uint32 PackStateBits(const FConstRefs& Features)
+	{
+		return PackStateBits(Features, TMakeIntegerSequence<uint32, NumFeatures>());
+	}
+
+	static void UnpackSimulatedStateBits(const FRefs& Features, UCharacterMovementComponent& MoveComp, uint32 Bits)
+	{
+		UnpackSimulatedStateBits(Features, MoveComp, Bits, TMakeIntegerSequence<uint32, NumFeatures>());
+	}
+
+	static void Initialize(const FRefs& Features, UCharacterMovementComponent& MoveComp)
+	{
+		VisitTupleElements([&MoveComp](auto& Feature) { Feature.Initialize(MoveComp); }, Features);
+	}
+
+	static float GetMaxSpeed(const FConstRefs& Features, const UCharacterMovementComponent& MoveComp, float MaxSpeed)
+	{
+		VisitTupleElements([&](const auto& Feature) { Feature.ModifyMaxSpeed(MoveComp, MaxSpeed); }, Features);
+		return MaxSpeed;
+	}
+
+	static float GetMaxAcceleration(const FConstRefs& Features, const UCharacterMovementComponent& MoveComp, float MaxAcceleration)
+	{
+		VisitTupleElements([&](const auto& Feature) { Feature.ModifyMaxAcceleration(MoveComp, MaxAcceleration); }, Features);
+		return MaxAcceleration;
+	}
+
+	static float GetMaxBrakingDeceleration(const FConstRefs& Features, const UCharacterMovementComponent& MoveComp, float MaxBrakingDeceleration)
+	{
+		VisitTupleElements([&](const auto& Feature) { Feature.ModifyMaxBrakingDeceleration(MoveComp, MaxBrakingDeceleration); }, Features);
+		return MaxBrakingDeceleration;
+	}
+
+	static float GetGroundFriction(const FConstRefs& Features, const UCharacterMovementComponent& MoveComp, float Friction)
+	{
+		VisitTupleElements([&](const auto& Feature) { Feature.ModifyGroundFriction(MoveComp, Friction); }, Features);
+		return Friction;
+	}
+
+	static float GetBrakingFriction(const FConstRefs& Features, const UCharacterMovementComponent& MoveComp, float Friction)
+	{
+		VisitTupleElements([&](const auto& Feature) { Feature.ModifyBrakingFriction(MoveComp, Friction); }, Features);
+		return Friction;
+	}
+
+	static void CalcVelocity(const FRefs& Features, UCharacterMovementComponent& MoveComp, float DeltaTime)
+	{
+		VisitTupleElements([&](auto& Feature) { Feature.CalcVelocity(MoveComp, DeltaTime); }, Features);
+	}
+
+	static void UpdateBeforeMovement(const FRefs& Features, UCharacterMovementComponent& MoveComp, float DeltaSeconds)
+	{
+		VisitTupleElements([&](auto& Feature) { Feature.UpdateBeforeMovement(MoveComp, DeltaSeconds); }, Features);
+	}
+
+	static void UpdateAfterMovement(const FRefs& Features, UCharacterMovementComponent& MoveComp, float DeltaSeconds)
+	{
+		VisitTupleElements([&](auto& Feature) { Feature.UpdateAfterMovement(MoveComp, DeltaSeconds); }, Features);
+	}
+
+	static bool ServerCheckClientError(const FConstRefs& Features, const FMoveData& MoveData)
+	{
+		bool bError = false;
+		VisitTupleElements([&bError](const auto& Feature, const auto& Data)
+		{
+			bError |= Feature.ServerCheckClientError(Data);
+		}, Features, MoveData);
+		return bError;
+	}
+
+	static void ApplyResponseData(const FRefs& Features, const FResponseData& ResponseData)
+	{
+		VisitTupleElements([](auto& Feature, const auto& Data) { Data.Apply(Feature); }, Features, ResponseData);
+	}
+
+private:
+	template<uint32... Indices>
+	static uint32 PackInputBits(const FConstRefs& Features, TIntegerSequence<uint32, Indices...>)
+	{
+		uint32 Bits = 0;
+		((Bits |= (Features.template Get<Indices>().GetInputBits() & MakeMask(TFeature<Indices>::NumInputBits))
+			<< GetInputBitOffset<Indices>()), ...);
+		return Bits;
+	}
+
+	template<uint32... Indices>
+	static void UnpackInputBits(const FRefs& Features, uint32 Bits, TIntegerSequence<uint32, Indices...>)
+	{
+		(Features.template Get<Indices>().SetInputBits(
+			(Bits >> GetInputBitOffset<Indices>()) & MakeMask(TFeature<Indices>::NumInputBits)), ...);
+	}
+
+	template<uint32... Indices>
+	static uint32 PackStateBits(const FConstRefs& Features, TIntegerSequence<uint32, Indices...>)
+	{
+		uint32 Bits = 0;
+		((Bits |= (Features.template Get<Indices>().GetStateBits() & MakeMask(TFeature<Indices>::NumStateBits))
+			<< GetStateBitOffset<Indices>()), ...);
+		return Bits;
+	}
+
+	template<uint32... Indices>
+	static void UnpackSimulatedStateBits(const FRefs& Features, UCharacterMovementComponent& MoveComp, uint32 Bits,
+		TIntegerSequence<uint32, Indices...>)
+	{
+		(Features.template Get<Indices>().SetSimulatedStateBits(MoveComp,
+			(Bits >> GetStateBitOffset<Indices>()) & MakeMask(TFeature<Indices>::NumStateBits)), ...);
+	}
+};
+
+/**
+ * Single saved move for every feature in TMovement::FFeatureSet
+ * TFeatureSet must be given explicitly when declaring these types inside TMovement, as it is not yet complete
+ */
+template<typename TMovement, typename TFeatureSet = typename TMovement::FFeatureSet>
+class TComposedSavedMove : public FSavedMove_Character
+{
+	using Super = FSavedMove_Character;
+	using FFeatureSet = TFeatureSet;
+
+public:
+	TComposedSavedMove()
+		: InputBits(0)
+	{}
+
+	virtual ~TComposedSavedMove() override
+	{}
+
+	/** Packed input bits of every feature */
+	uint32 InputBits;
+
+	typename FFeatureSet::FSavedStates SavedStates;
+
+	virtual void Clear() override
+	{
+		Super::Clear();
+
+		InputBits = 0;
+		VisitTupleElements([](auto& SavedState) { SavedState.Clear(); }, SavedStates);
+	}
+
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel,
+		FNetworkPredictionData_Client_Character& ClientData) override
+	{
+		Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+		if (const TMovement* MoveComp = Cast<TMovement>(C->GetCharacterMovement()))
+		{
+			InputBits = FFeatureSet::PackInputBits(MoveComp->GetFeatures());
+		}
+	}
+
+	virtual void SetInitialPosition(ACharacter* C) override
+	{
+		Super::SetInitialPosition(C);
+
+		if (const TMovement* MoveComp = C ? Cast<TMovement>(C->GetCharacterMovement()) : nullptr)
+		{
+			VisitTupleElements([](auto& SavedState, const auto& Feature) { SavedState.SetInitialPosition(Feature); },
+				SavedStates, MoveComp->GetFeatures());
+		}
+	}
+
+	virtual void PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode) override
+	{
+		if (const TMovement* MoveComp = C ? Cast<TMovement>(C->GetCharacterMovement()) : nullptr)
+		{
+			bool bFeatureForceNoCombine = false;
+			VisitTupleElements([&bFeatureForceNoCombine](auto& SavedState, const auto& Feature)
+			{
+				SavedState.PostUpdate(Feature, bFeatureForceNoCombine);
+			}, SavedStates, MoveComp->GetFeatures());
+
+			// Don't combine moves if a feature changed over the course of the move
+			if (PostUpdateMode == PostUpdate_Record && bFeatureForceNoCombine)
+			{
+				bForceNoCombine = true;
+			}
+		}
+
+		Super::PostUpdate(C, PostUpdateMode);
+	}
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override
+	{
+		const TComposedSavedMove* SavedMove = static_cast<const TComposedSavedMove*>(NewMove.Get());
+
+		if (InputBits != SavedMove->InputBits)
+		{
+			return false;
+		}
+
+		bool bCanCombine = true;
+		VisitTupleElements([&bCanCombine](const auto& SavedState, const auto& NewSavedState)
+		{
+			bCanCombine &= SavedState.CanCombineWith(NewSavedState);
+		}, SavedStates, SavedMove->SavedStates);
+
+		return bCanCombine && Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+	}
+
+	virtual void CombineWith(const FSavedMove_Character* OldMove, ACharacter* C, APlayerController* PC,
+		const FVector& OldStartLocation) override
+	{
+		Super::CombineWith(OldMove, C, PC, OldStartLocation);
+
+		const TComposedSavedMove* SavedOldMove = static_cast<const TComposedSavedMove*>(OldMove);
+		if (TMovement* MoveComp = C ? Cast<TMovement>(C->GetCharacterMovement()) : nullptr)
+		{
+			VisitTupleElements([](const auto& OldSavedState, auto& Feature) { OldSavedState.CombineWith(Feature); },
+				SavedOldMove->SavedStates, MoveComp->GetFeatures());
+		}
+	}
+
+	virtual void PrepMoveFor(ACharacter* C) override
+	{
+		Super::PrepMoveFor(C);
+
+		// Restore the inputs this move was made with, for replaying after a correction
+		if (TMovement* MoveComp = C ? Cast<TMovement>(C->GetCharacterMovement()) : nullptr)
+		{
+			FFeatureSet::UnpackInputBits(MoveComp->GetFeatures(), InputBits);
+		}
+	}
+};
+
+/** Single network move data for every feature in TMovement::FFeatureSet */
+template<typename TMovement, typename TFeatureSet = typename TMovement::FFeatureSet>
+struct TComposedNetworkMoveData : FCharacterNetworkMoveData
+{  // Client ➜ Server
+	using Super = FCharacterNetworkMoveData;
+	using FFeatureSet = TFeatureSet;
+
+	TComposedNetworkMoveData()
+		: InputBits(0)
+	{}
+
+	/** Packed input bits of every feature, leaves the compressed flags free for the engine and other shells */
+	uint32 InputBits;
+
+	typename FFeatureSet::FMoveData FeatureMoveData;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override
+	{
+		Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+		// Client ➜ Server
+		const TComposedSavedMove<TMovement, TFeatureSet>& SavedMove =
+			static_cast<const TComposedSavedMove<TMovement, TFeatureSet>&>(ClientMove);
+		InputBits = SavedMove.InputBits;
+		VisitTupleElements([](auto& Data, const auto& SavedState) { Data.Fill(SavedState); },
+			FeatureMoveData, SavedMove.SavedStates);
+	}
+
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap,
+		ENetworkMoveType MoveType) override
+	{
+		Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+		// Client ➜ Server
+		if constexpr (FFeatureSet::NumInputBits > 0)
+		{
+			FPredictedInputFlags::SerializeBits(Ar, InputBits);
+		}
+		VisitTupleElements([&Ar](auto& Data) { Data.Serialize(Ar); }, FeatureMoveData);
+
+		return !Ar.IsError();
+	}
+};
+
+template<typename TMovement, typename TFeatureSet = typename TMovement::FFeatureSet>
+struct TComposedNetworkMoveDataContainer : FCharacterNetworkMoveDataContainer
+{  // Client ➜ Server
+	using Super = FCharacterNetworkMoveDataContainer;
+
+	TComposedNetworkMoveDataContainer()
+	{
+		NewMoveData = &MoveData[0];
+		PendingMoveData = &MoveData[1];
+		OldMoveData = &MoveData[2];
+	}
+
+private:
+	TComposedNetworkMoveData<TMovement, TFeatureSet> MoveData[3];
+};
+
+/** Single move response for every feature in TMovement::FFeatureSet */
+template<typename TMovement, typename TFeatureSet = typename TMovement::FFeatureSet>
+struct TComposedMoveResponseDataContainer : FCharacterMoveResponseDataContainer
+{  // Server ➜ Client
+	using Super = FCharacterMoveResponseDataContainer;
+	using FFeatureSet = TFeatureSet;
+
+	typename FFeatureSet::FResponseData FeatureResponseData;
+
+	virtual void ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement,
+		const FClientAdjustment& PendingAdjustment) override
+	{
+		Super::ServerFillResponseData(CharacterMovement, PendingAdjustment);
+
+		// Server ➜ Client
+		const TMovement& MoveComp = static_cast<const TMovement&>(CharacterMovement);
+		VisitTupleElements([](auto& Data, const auto& Feature) { Data.Fill(Feature); },
+			FeatureResponseData, MoveComp.GetFeatures());
+	}
+
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap) override
+	{
+		if (!Super::Serialize(CharacterMovement, Ar, PackageMap))
+		{
+			return false;
+		}
+
+		// Server ➜ Client
+		if (IsCorrection())
+		{
+			VisitTupleElements([&Ar](auto& Data) { Data.Serialize(Ar); }, FeatureResponseData);
+		}
+
+		return !Ar.IsError();
+	}
+};
+
+template<typename TMovement>
+class TComposedPredictionData_Client : public FNetworkPredictionData_Client_Character
+{
+	using Super = FNetworkPredictionData_Client_Character;
+
+public:
+	TComposedPredictionData_Client(const UCharacterMovementComponent& ClientMovement)
+	: Super(ClientMovement)
+	{}
+
+	virtual FSavedMovePtr AllocateNewMove() override
+	{
+		return MakeShared<TComposedSavedMove<TMovement>>();
+	}
+};
+
+/**
+ * Everything a composed movement component does beyond choosing its features, shared by every feature list
+ * TMovement declares `using FFeatureSet = TPredictedFeatureSet<...>` with its features as the template parameters,
+ * a property for each feature and GetFeatures(), then forwards its overrides here
+ * @see UComposedMovement
+ */
+template<typename TMovement>
+struct TComposedMovement
+{
+	using FFeatureSet = typename TMovement::FFeatureSet;
+	using FNetworkMoveData = TComposedNetworkMoveData<TMovement, FFeatureSet>;
+	using FMoveResponseDataContainer = TComposedMoveResponseDataContainer<TMovement, FFeatureSet>;
+
+	/** @return Packed state bits once every feature is initialized */
+	static uint32 Initialize(TMovement& MoveComp)
+	{
+		FFeatureSet::Initialize(MoveComp.GetFeatures(), MoveComp);
+		return GetStateBits(MoveComp);
+	}
+
+	static uint32 GetInputBits(const TMovement& MoveComp)
+	{
+		return FFeatureSet::PackInputBits(MoveComp.GetFeatures());
+	}
+
+	static void SetInputBits(TMovement& MoveComp, uint32 InputBits)
+	{
+		FFeatureSet::UnpackInputBits(MoveComp.GetFeatures(), InputBits);
+	}
+
+	static uint32 GetStateBits(const TMovement& MoveComp)
+	{
+		return FFeatureSet::PackStateBits(MoveComp.GetFeatures());
+	}
+
+	static void SetSimulatedStateBits(TMovement& MoveComp, uint32 StateBits)
+	{
+		FFeatureSet::UnpackSimulatedStateBits(MoveComp.GetFeatures(), MoveComp, StateBits);
+	}
+
+	static float GetMaxSpeed(const TMovement& MoveComp, float MaxSpeed)
+	{
+		return FFeatureSet::GetMaxSpeed(MoveComp.GetFeatures(), MoveComp, MaxSpeed);
+	}
+
+	static float GetMaxAcceleration(const TMovement& MoveComp, float MaxAcceleration)
+	{
+		return FFeatureSet::GetMaxAcceleration(MoveComp.GetFeatures(), MoveComp, MaxAcceleration);
+	}
+
+	static float GetMaxBrakingDeceleration(const TMovement& MoveComp, float MaxBrakingDeceleration)
+	{
+		return FFeatureSet::GetMaxBrakingDeceleration(MoveComp.GetFeatures(), MoveComp, MaxBrakingDeceleration);
+	}
+
+	/** @return Friction to pass to Super::CalcVelocity() */
+	static float CalcVelocity(TMovement& MoveComp, float DeltaTime, float Friction)
+	{
+		FFeatureSet::CalcVelocity(MoveComp.GetFeatures(), MoveComp, DeltaTime);
+		return FFeatureSet::GetGroundFriction(AsConst(MoveComp).GetFeatures(), MoveComp, Friction);
+	}
+
+	/** @return Friction to pass to Super::ApplyVelocityBraking() */
+	static float GetBrakingFriction(const TMovement& MoveComp, float Friction)
+	{
+		return FFeatureSet::GetBrakingFriction(MoveComp.GetFeatures(), MoveComp, Friction);
+	}
+
+	/** @return True if the features were updated, simulated proxies get replicated state bits instead */
+	static bool UpdateBeforeMovement(TMovement& MoveComp, float DeltaSeconds)
+	{
+		if (MoveComp.GetCharacterOwner()->GetLocalRole() == ROLE_SimulatedProxy)
+		{
+			return false;
+		}
+		FFeatureSet::UpdateBeforeMovement(MoveComp.GetFeatures(), MoveComp, DeltaSeconds);
+		return true;
+	}
+
+	/** @return True if the features were updated, simulated proxies get replicated state bits instead */
+	static bool UpdateAfterMovement(TMovement& MoveComp, float DeltaSeconds)
+	{
+		if (MoveComp.GetCharacterOwner()->GetLocalRole() == ROLE_SimulatedProxy)
+		{
+			return false;
+		}
+		FFeatureSet::UpdateAfterMovement(MoveComp.GetFeatures(), MoveComp, DeltaSeconds);
+		return true;
+	}
+
+	/** Server receives the packed inputs in the move data rather than the compressed flags */
+	static void ReceiveInputBits(TMovement& MoveComp, const FCharacterNetworkMoveData* MoveData)
+	{
+		if (MoveData)
+		{
+			SetInputBits(MoveComp, static_cast<const FNetworkMoveData*>(MoveData)->InputBits);
+		}
+	}
+
+	static void ApplyResponseData(TMovement& MoveComp, const FCharacterMoveResponseDataContainer& MoveResponse)
+	{
+		FFeatureSet::ApplyResponseData(MoveComp.GetFeatures(),
+			static_cast<const FMoveResponseDataContainer&>(MoveResponse).FeatureResponseData);
+	}
+
+	static bool ServerCheckClientError(const TMovement& MoveComp, const FCharacterNetworkMoveData* MoveData)
+	{
+		return FFeatureSet::ServerCheckClientError(MoveComp.GetFeatures(),
+			static_cast<const FNetworkMoveData*>(MoveData)->FeatureMoveData);
+	}
+
+	static FNetworkPredictionData_Client_Character* AllocatePredictionData_Client(const TMovement& MoveComp)
+	{
+		return new TComposedPredictionData_Client<TMovement>(MoveComp);
+	}
+};
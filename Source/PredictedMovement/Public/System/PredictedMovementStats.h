@@ -0,0 +1,12 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/**
+ * Stat group shared by all PredictedMovement shells
+ * Use `stat PredictedMovement` to display
+ */
+DECLARE_STATS_GROUP(TEXT("PredictedMovement"), STATGROUP_PredictedMovement, STATCAT_Advanced);